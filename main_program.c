@@ -1,10 +1,16 @@
 #include <stdio.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
 #include <time.h>
 
+#include "moore_curve_cache.h"
+#include "moore_curve_codec.h"
+#include "moore_curve_knn.h"
+#include "moore_curve_server.h"
+
 #define SVG_FILE_NAME "svg_result.svg"
 
 // Errors output
@@ -24,12 +30,32 @@ int invalid_solution_type(int32_t max_supported_solution_number);
 
 int invalid_number_of_benchmarking_cycles();
 
+int invalid_number_of_threads();
+
 int invalid_average_benchmark();
 
 int failed_malloc();
 
 int failed_to_open_file(const char *file_name);
 
+int failed_to_write_cache(const char *cache_dir);
+
+int failed_to_serve(const char *socket_path);
+
+int failed_load_test(const char *socket_path);
+
+int failed_jobs(const char *jobs_file);
+
+int invalid_image_size();
+
+int failed_to_render(const char *file_name);
+
+int failed_verification(int32_t degree);
+
+int invalid_knn_parameters();
+
+int failed_codec(int result, const char* text_file, const char* codec_file);
+
 void print_help_message();
 
 
@@ -41,6 +67,32 @@ void moore_gray_code(unsigned degree, coord_t* x, coord_t* y);
 
 void moore_recursive(unsigned degree, coord_t* x, coord_t* y);
 
+void moore_incremental(unsigned degree, coord_t* x, coord_t* y);
+
+void moore_parallel(unsigned degree, coord_t* x, coord_t* y);
+
+void moore_walker(unsigned degree, coord_t* x, coord_t* y);
+
+void moore_parallel_set_threads(int threads_count);
+
+void moore_parallel_set_report(bool report);
+
+void moore_parallel_print_report();
+
+coord_t* allocate_coords(size_t count);
+
+void free_coords(coord_t* coords, size_t count);
+
+int run_jobs(const char* jobs_file, int solutions_count);
+
+bool render_moore_curve(unsigned degree, const char* file_name, int width, int height);
+
+int verify_moore_curve(unsigned degree, int solution, int solutions_count);
+
+void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y);
+
+void print_to_svg(FILE *fptr, unsigned degree, const int32_t points_number, coord_t* x, coord_t* y);
+
 
 int number_or_default(int len, char* strings[], size_t* index, int default_value) {
     if (*index < len && isdigit(strings[*index][0])) {
@@ -69,6 +121,9 @@ double calc_moore_curve_points(unsigned degree, coord_t* x, coord_t* y, int solu
         case 0: moore(degree, x, y); break;
         case 1: moore_gray_code(degree, x, y); break;
         case 2: moore_recursive(degree, x, y); break;
+        case 3: moore_incremental(degree, x, y); break;
+        case 4: moore_parallel(degree, x, y); break;
+        case 5: moore_walker(degree, x, y); break;
     }
 
     if (with_benchmarking && !malloc_is_failed()) {
@@ -80,36 +135,41 @@ double calc_moore_curve_points(unsigned degree, coord_t* x, coord_t* y, int solu
     return 0.0;
 }
 
-void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y) {
-    for (size_t i = 0; i < points_number; i++) {
-        fprintf(fptr, "%d, %d\n", x[i], y[i]);
+/*
+ * Maps the points from the cache file. If the cache file is missing, cache->mapping stays NULL
+ */
+double load_moore_curve_points_from_cache(const char* cache_dir, unsigned degree, bool verify_payload,
+                                          struct MooreCurveCache* cache, bool with_benchmarking) {
+    struct timespec start;
+    struct timespec end;
+
+    if (with_benchmarking) clock_gettime(CLOCK_MONOTONIC , &start);
+
+    if (load_cached_moore_curve(cache_dir, degree, verify_payload, cache) && with_benchmarking) {
+        clock_gettime(CLOCK_MONOTONIC , &end);
+        double time = end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+        printf("Time: %f (cache)\n", time);
+        return time;
     }
+    return 0.0;
 }
 
-void print_to_svg(FILE *fptr, unsigned degree, const int32_t points_number, coord_t* x, coord_t* y) {
-    coord_t max_x = 0;
-    coord_t max_y = 0;
+bool render_moore_curve_image(unsigned degree, const char* file_name, int width, int height, bool with_benchmarking) {
+    struct timespec start;
+    struct timespec end;
 
-    for (size_t i = 0; i < points_number; i++) {
-        coord_t new_x = x[i] * 100;
-        if (max_x < new_x) {
-            max_x = new_x;
-        }
+    if (with_benchmarking) clock_gettime(CLOCK_MONOTONIC , &start);
 
-        coord_t new_y = y[i] * 100;
-        if (max_y < new_y) {
-            max_y = new_y;
-        } 
+    if (!render_moore_curve(degree, file_name, width, height)) {
+        return false;
     }
 
-    fprintf(fptr, "<?xml version=\"1.0\" standalone=\"no\"?>\n");
-    fprintf(fptr, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" version=\"1.1\" baseProfile=\"full\">\n", max_x, max_y);
-    fprintf(fptr, "<polyline points=\"");
-    for (size_t i = 0; i < points_number; i++) {
-        fprintf(fptr, "%d,%d ", x[i] * 100, y[i] * 100);
+    if (with_benchmarking) {
+        clock_gettime(CLOCK_MONOTONIC , &end);
+        double time = end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+        printf("Time: %f\n", time);
     }
-    fprintf(fptr, "\" style=\"fill:none;stroke:black;stroke-width:2\"/>\n");
-    fprintf(fptr, "</svg>\n");
+    return true;
 }
 
 int32_t get_point_numbers(int degree) {
@@ -122,25 +182,54 @@ int main(int argc, char* argv[]) {
     }
 
     // Consts that define arguments index
-    static const int ARGUMENTS_COUNT = 6;
+    static const int ARGUMENTS_COUNT = 19;
     static const int SOLUTION_TYPE_ARGUMENT = 0; // Optional argument
     static const int BENCHMARK_ARGUMENT = 1; // Optional argument
     static const int CURVE_DEGREE_ARGUMENT = 2; // Must be specified
     static const int OUTPUT_FILE_ARGUMENT = 3; // Must be specified
     static const int HELP_ARGUMENT = 4; // Optional argument
     static const int AVERAGE_BENCHMARK_ARGUMENT = 5; // Optional argument
+    static const int CACHE_DIR_ARGUMENT = 6; // Optional argument
+    static const int SERVE_ARGUMENT = 7; // Optional argument
+    static const int LOAD_TEST_ARGUMENT = 8; // Optional argument
+    static const int JOBS_ARGUMENT = 9; // Optional argument
+    static const int THREADS_ARGUMENT = 10; // Optional argument
+    static const int RASTER_ARGUMENT = 11; // Optional argument
+    static const int IMAGE_SIZE_ARGUMENT = 12; // Optional argument
+    static const int VERIFY_ARGUMENT = 13; // Optional argument
+    static const int KNN_ARGUMENT = 14; // Optional argument
+    static const int ENCODE_ARGUMENT = 15; // Optional argument
+    static const int ENCODE_POINTS_ARGUMENT = 16; // Optional argument
+    static const int DECODE_ARGUMENT = 17; // Optional argument
+    static const int VERIFY_CACHE_ARGUMENT = 18; // Optional argument
 
     bool argument_is_specified[ARGUMENTS_COUNT];
     for (size_t i = 0; i < ARGUMENTS_COUNT; i++) {
         argument_is_specified[i] = false;
     }
 
-    static const int SOLUTIONS_COUNT = 3;
+    static const int SOLUTIONS_COUNT = 6;
 
     int solution_type = 0;
     int number_of_benchmarking_cycles = 1;
+    int threads_count = 0;
     int moore_curve_degree = -1;
-    const char* output_file;
+    const char* output_file = NULL;
+    const char* cache_dir = NULL;
+    const char* socket_path = NULL;
+    const char* jobs_file = NULL;
+    const char* image_file = NULL;
+    const char* codec_file = NULL;
+    const char* points_file = NULL;
+    int image_width = 1024;
+    int image_height = 1024;
+    int load_test_requests_count = 100000;
+    int load_test_batch_size = 16;
+    int knn_points_count = 1000000;
+    int knn_queries_count = 1000;
+    int knn_k = 8;
+    int knn_window = 32;
+    int knn_curves_count = 2;
 
     for (size_t i = 1; i < argc;) {
         if (expect_word("-V", argv[i], &i)) {
@@ -151,6 +240,10 @@ int main(int argc, char* argv[]) {
             argument_is_specified[BENCHMARK_ARGUMENT] = true;
             number_of_benchmarking_cycles = number_or_default(argc, argv, &i, 1);
             continue;
+        } else if (expect_word("-T", argv[i], &i)) {
+            argument_is_specified[THREADS_ARGUMENT] = true;
+            threads_count = number_or_default(argc, argv, &i, -1);
+            continue;
         } else if (expect_word("-n", argv[i], &i)) {
             argument_is_specified[CURVE_DEGREE_ARGUMENT] = true;
             moore_curve_degree = number_or_default(argc, argv, &i, -1);
@@ -159,6 +252,85 @@ int main(int argc, char* argv[]) {
             argument_is_specified[OUTPUT_FILE_ARGUMENT] = true;
             output_file = argv[i++];
             continue;
+        } else if (expect_word("--cache-dir", argv[i], &i)) {
+            argument_is_specified[CACHE_DIR_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Cache directory");
+            }
+            cache_dir = argv[i++];
+            continue;
+        } else if (expect_word("--verify-cache", argv[i], &i)) {
+            argument_is_specified[VERIFY_CACHE_ARGUMENT] = true;
+            continue;
+        } else if (expect_word("--serve", argv[i], &i)) {
+            argument_is_specified[SERVE_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Socket path");
+            }
+            socket_path = argv[i++];
+            continue;
+        } else if (expect_word("--load-test", argv[i], &i)) {
+            argument_is_specified[LOAD_TEST_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Socket path");
+            }
+            socket_path = argv[i++];
+            load_test_requests_count = number_or_default(argc, argv, &i, load_test_requests_count);
+            load_test_batch_size = number_or_default(argc, argv, &i, load_test_batch_size);
+            continue;
+        } else if (expect_word("--jobs", argv[i], &i)) {
+            argument_is_specified[JOBS_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Jobs file");
+            }
+            jobs_file = argv[i++];
+            continue;
+        } else if (expect_word("-r", argv[i], &i)) {
+            argument_is_specified[RASTER_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Image file");
+            }
+            image_file = argv[i++];
+            continue;
+        } else if (expect_word("--size", argv[i], &i)) {
+            argument_is_specified[IMAGE_SIZE_ARGUMENT] = true;
+            if (i >= argc || sscanf(argv[i++], "%dx%d", &image_width, &image_height) != 2) {
+                return invalid_image_size();
+            }
+            continue;
+        } else if (expect_word("--encode", argv[i], &i)) {
+            argument_is_specified[ENCODE_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Compressed file");
+            }
+            codec_file = argv[i++];
+            continue;
+        } else if (expect_word("--encode-points", argv[i], &i)) {
+            argument_is_specified[ENCODE_POINTS_ARGUMENT] = true;
+            if (i + 1 >= argc) {
+                return missing_argument_error("Points file and compressed file");
+            }
+            points_file = argv[i++];
+            codec_file = argv[i++];
+            continue;
+        } else if (expect_word("--decode", argv[i], &i)) {
+            argument_is_specified[DECODE_ARGUMENT] = true;
+            if (i >= argc) {
+                return missing_argument_error("Compressed file");
+            }
+            codec_file = argv[i++];
+            continue;
+        } else if (expect_word("--knn", argv[i], &i)) {
+            argument_is_specified[KNN_ARGUMENT] = true;
+            knn_points_count = number_or_default(argc, argv, &i, knn_points_count);
+            knn_queries_count = number_or_default(argc, argv, &i, knn_queries_count);
+            knn_k = number_or_default(argc, argv, &i, knn_k);
+            knn_window = number_or_default(argc, argv, &i, knn_window);
+            knn_curves_count = number_or_default(argc, argv, &i, knn_curves_count);
+            continue;
+        } else if (expect_word("--verify", argv[i], &i)) {
+            argument_is_specified[VERIFY_ARGUMENT] = true;
+            continue;
         } else if (expect_word("-AB", argv[i], &i)) {
             argument_is_specified[AVERAGE_BENCHMARK_ARGUMENT] = true;
             continue;
@@ -174,6 +346,101 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (argument_is_specified[SERVE_ARGUMENT]) {
+        return serve_moore_curve(socket_path) == 0 ? 0 : failed_to_serve(socket_path);
+    }
+
+    if (argument_is_specified[JOBS_ARGUMENT]) {
+        return run_jobs(jobs_file, SOLUTIONS_COUNT) == 0 ? 0 : failed_jobs(jobs_file);
+    }
+
+    if (argument_is_specified[LOAD_TEST_ARGUMENT]) {
+        if (moore_curve_degree == -1) {
+            moore_curve_degree = 10;
+        }
+        if (moore_curve_degree < 1 || moore_curve_degree > 15) {
+            return invalid_moore_curve_degree();
+        }
+        if (load_test_requests_count < 1 || load_test_batch_size < 1) {
+            return error("Invalid load test parameters. The numbers of requests and points must be at least 1");
+        }
+        return load_test_moore_curve(socket_path, moore_curve_degree, load_test_requests_count, load_test_batch_size) == 0
+                ? 0 : failed_load_test(socket_path);
+    }
+
+    if (argument_is_specified[RASTER_ARGUMENT]) {
+        if (!argument_is_specified[CURVE_DEGREE_ARGUMENT] || moore_curve_degree == -1) {
+            return missing_argument_error("Curve degree");
+        }
+        if (moore_curve_degree < 1 || moore_curve_degree > 15) {
+            return invalid_moore_curve_degree();
+        }
+        if (image_width < 1 || image_height < 1 || image_width > 65536 || image_height > 65536) {
+            return invalid_image_size();
+        }
+        return render_moore_curve_image(moore_curve_degree, image_file, image_width, image_height,
+                                        argument_is_specified[BENCHMARK_ARGUMENT]) ? 0 : failed_to_render(image_file);
+    }
+
+    if (argument_is_specified[DECODE_ARGUMENT]) {
+        if (!argument_is_specified[OUTPUT_FILE_ARGUMENT]) {
+            return missing_argument_error("Output file");
+        }
+        const int result = decode_to_text(codec_file, output_file, argument_is_specified[BENCHMARK_ARGUMENT]);
+        return result == 0 ? 0 : failed_codec(result, output_file, codec_file);
+    }
+
+    if (argument_is_specified[ENCODE_ARGUMENT] || argument_is_specified[ENCODE_POINTS_ARGUMENT]) {
+        if (!argument_is_specified[CURVE_DEGREE_ARGUMENT] || moore_curve_degree == -1) {
+            return missing_argument_error("Curve degree");
+        }
+        if (moore_curve_degree < 1 || moore_curve_degree > 15) {
+            return invalid_moore_curve_degree();
+        }
+        if (argument_is_specified[ENCODE_POINTS_ARGUMENT]) {
+            const int result = encode_points_file(moore_curve_degree, points_file, codec_file);
+            return result == 0 ? 0 : failed_codec(result, points_file, codec_file);
+        }
+        if (solution_type < 0 || solution_type >= SOLUTIONS_COUNT) {
+            return invalid_solution_type(SOLUTIONS_COUNT);
+        }
+        const int result = encode_moore_curve(moore_curve_degree, solution_type, codec_file);
+        return result == 0 ? 0 : failed_codec(result, NULL, codec_file);
+    }
+
+    if (argument_is_specified[KNN_ARGUMENT]) {
+        if (moore_curve_degree == -1) {
+            moore_curve_degree = 10;
+        }
+        if (moore_curve_degree < 1 || moore_curve_degree > 14) {
+            return error("Invalid moore curve degree. The number must be between 1 and 14");
+        }
+        if (knn_points_count < 1 || knn_queries_count < 1 || knn_k < 1 || knn_window < 1
+                || knn_curves_count < 1 || knn_curves_count > 8) {
+            return invalid_knn_parameters();
+        }
+        return run_knn_benchmark(moore_curve_degree, knn_points_count, knn_queries_count, knn_k, knn_window,
+                                 knn_curves_count);
+    }
+
+    if (argument_is_specified[VERIFY_ARGUMENT]) {
+        if (!argument_is_specified[CURVE_DEGREE_ARGUMENT] || moore_curve_degree == -1) {
+            return missing_argument_error("Curve degree");
+        }
+        if (moore_curve_degree < 1 || moore_curve_degree > 15) {
+            return invalid_moore_curve_degree();
+        }
+        if (argument_is_specified[SOLUTION_TYPE_ARGUMENT] && (solution_type < 0 || solution_type >= SOLUTIONS_COUNT)) {
+            return invalid_solution_type(SOLUTIONS_COUNT);
+        }
+        if (argument_is_specified[THREADS_ARGUMENT] && threads_count < 1) {
+            return invalid_number_of_threads();
+        }
+        moore_parallel_set_threads(threads_count);
+        return verify_moore_curve(moore_curve_degree, argument_is_specified[SOLUTION_TYPE_ARGUMENT] ? solution_type : -1,
+                                  SOLUTIONS_COUNT) == 0 ? 0 : failed_verification(moore_curve_degree);
+    }
+
     if (!argument_is_specified[CURVE_DEGREE_ARGUMENT] || moore_curve_degree == -1 || !argument_is_specified[OUTPUT_FILE_ARGUMENT]) {
         return missing_argument_error(!argument_is_specified[OUTPUT_FILE_ARGUMENT] ? "Output file" : "Curve degree");
     }
@@ -186,6 +453,12 @@ int main(int argc, char* argv[]) {
         return invalid_solution_type(SOLUTIONS_COUNT);
     }
 
+    if (argument_is_specified[THREADS_ARGUMENT] && threads_count < 1) {
+        return invalid_number_of_threads();
+    }
+    moore_parallel_set_threads(threads_count);
+    moore_parallel_set_report(argument_is_specified[BENCHMARK_ARGUMENT]);
+
     if (number_of_benchmarking_cycles < 1) {
         return invalid_number_of_benchmarking_cycles();
     }
@@ -197,26 +470,49 @@ int main(int argc, char* argv[]) {
     double summary_time = 0.0;
     const int32_t point_numbers = get_point_numbers(moore_curve_degree);
     for (int cycle = 0; cycle < number_of_benchmarking_cycles; cycle++) {
-        coord_t* x = (coord_t*) malloc(sizeof(coord_t) * point_numbers);
-        if (x == NULL) {
-            return failed_malloc();
-        }
-
-        coord_t* y = (coord_t*) malloc(sizeof(coord_t) * point_numbers);
-        if (y == NULL) {
-            return failed_malloc();
+        coord_t* x;
+        coord_t* y;
+
+        // Map moore curve points from the cache file if it was written by previous runs
+        struct MooreCurveCache cache = {NULL, 0, NULL, NULL};
+        if (argument_is_specified[CACHE_DIR_ARGUMENT]) {
+            summary_time += load_moore_curve_points_from_cache(cache_dir, moore_curve_degree,
+                                                               argument_is_specified[VERIFY_CACHE_ARGUMENT], &cache,
+                                                               argument_is_specified[BENCHMARK_ARGUMENT]);
         }
+        const bool is_cached = cache.mapping != NULL;
 
-
-        // Calculate moore curve points
         FILE *moore_curve_fptr;
         moore_curve_fptr = fopen(output_file, "w");
         if (moore_curve_fptr == NULL) {
             return failed_to_open_file(output_file);
         }
-        summary_time += calc_moore_curve_points(moore_curve_degree, x, y, solution_type, argument_is_specified[BENCHMARK_ARGUMENT]);
-        if (malloc_is_failed()) {
-            return failed_malloc();
+
+        if (is_cached) {
+            x = cache.x;
+            y = cache.y;
+        } else {
+            x = allocate_coords(point_numbers);
+            if (x == NULL) {
+                return failed_malloc();
+            }
+
+            y = allocate_coords(point_numbers);
+            if (y == NULL) {
+                return failed_malloc();
+            }
+
+            // Calculate moore curve points
+            summary_time += calc_moore_curve_points(moore_curve_degree, x, y, solution_type, argument_is_specified[BENCHMARK_ARGUMENT]);
+            if (malloc_is_failed()) {
+                return failed_malloc();
+            }
+            // Placement of the parallel solution is printed after the measured call
+            moore_parallel_print_report();
+
+            if (argument_is_specified[CACHE_DIR_ARGUMENT] && !store_cached_moore_curve(cache_dir, moore_curve_degree, x, y)) {
+                return failed_to_write_cache(cache_dir);
+            }
         }
         print_moore_curve_points(moore_curve_fptr, point_numbers, x, y);
         fclose(moore_curve_fptr);
@@ -231,8 +527,12 @@ int main(int argc, char* argv[]) {
         print_to_svg(svg_fptr, moore_curve_degree, point_numbers, x, y);
         fclose(svg_fptr);
 
-        free(x);
-        free(y);
+        if (is_cached) {
+            unload_cached_moore_curve(&cache);
+        } else {
+            free_coords(x, point_numbers);
+            free_coords(y, point_numbers);
+        }
     }
 
     if (argument_is_specified[AVERAGE_BENCHMARK_ARGUMENT]) {
@@ -273,6 +573,10 @@ int invalid_number_of_benchmarking_cycles() {
     return error("Invalid number of benchmarking cycles. The number must be at least 1");
 }
 
+int invalid_number_of_threads() {
+    return error("Invalid number of threads. The number must be at least 1");
+}
+
 int invalid_average_benchmark() {
     return error("Benchmark parameter must be specified too");
 }
@@ -285,16 +589,85 @@ int failed_to_open_file(const char *file_name) {
     return error_with_two_string("Failed to open the file ", file_name);
 }
 
+int failed_to_write_cache(const char *cache_dir) {
+    return error_with_two_string("Failed to write the cache file to the directory ", cache_dir);
+}
+
+int failed_to_serve(const char *socket_path) {
+    return error_with_two_string("Failed to serve on the socket ", socket_path);
+}
+
+int failed_load_test(const char *socket_path) {
+    return error_with_two_string("Load test failed on the socket ", socket_path);
+}
+
+int failed_jobs(const char *jobs_file) {
+    return error_with_two_string("Failed to run the jobs from the file ", jobs_file);
+}
+
+int invalid_image_size() {
+    return error("Invalid image size. Use WxH, both numbers must be between 1 and 65536");
+}
+
+int failed_to_render(const char *file_name) {
+    return error_with_two_string("Failed to render the image ", file_name);
+}
+
+int failed_verification(int32_t degree) {
+    return error_and_number("Verification failed for the moore curve of degree ", degree);
+}
+
+int invalid_knn_parameters() {
+    return error("Invalid kNN parameters. The numbers must be at least 1, the number of curves must be at most 8");
+}
+
+int failed_codec(int result, const char* text_file, const char* codec_file) {
+    if (result == TEXT_FILE_FAILED) {
+        return error_with_two_string("Failed to read or write the points file ", text_file);
+    }
+    return error_with_two_string("Failed to encode or decode the compressed file ", codec_file);
+}
+
 void print_help_message() {
     printf("Usage: make\n./moore_curve [ARGUMENT 1] [ARGUMENT 2] ...\n\n");
     printf("Implementation calculates moore curve points for the given N and prints the result to the given file. It generates svg file too.\n\n");
     printf("Run arguments:\n");
     printf("       -V <Number>       Specifies which solution is used to find the answer.\n");
-    printf("                         Print 0 for iterative solution, 1 for grey code solution, 2 for recursive solution.\n");
+    printf("                         Print 0 for iterative solution, 1 for grey code solution, 2 for recursive solution,\n");
+    printf("                         3 for incremental solution that reuses the curve cached by the previous calls,\n");
+    printf("                         4 for parallel solution with NUMA-aware placement of the points,\n");
+    printf("                         5 for gray code walker that updates only the changed levels of the previous point.\n");
     printf("                         By default, the iterative solution is used.\n");
+    printf("       -T <Number>       Number of threads of the parallel solution. By default, the number of CPUs.\n");
     printf("       -B <Number>       Enables benchmarking. You can also specify the number of function calls.\n");
     printf("       -AB               If specified prints the average benchmarking. You can also specify the number of function calls.\n");
     printf("       -n <Number>       Determines the degree N of the moore curve. Argument must be specified.\n");
     printf("       -o <File name>    Defines the file to which the result will be written in svg format. Argument must be specified.\n");
+    printf("       --cache-dir <Dir> Saves the calculated points to the binary cache file in the given directory.\n");
+    printf("                         Next runs map the cache file instead of calculating the points again.\n");
+    printf("       --verify-cache    Checks the checksum of the whole cache file before it is used. Without it only\n");
+    printf("                         the header and the size are checked and the pages are read on demand.\n");
+    printf("       --serve <Socket>  Runs the daemon which answers batched binary requests on the unix domain socket:\n");
+    printf("                         index to point, point to index, index range and rectangle to index ranges.\n");
+    printf("       --load-test <Socket> [<Requests>] [<Points>]\n");
+    printf("                         Sends requests to the daemon and prints QPS and latency. Uses the degree from -n (10 by default).\n");
+    printf("       --jobs <File>     Runs the jobs from the file on the pool of threads and prints the throughput summary.\n");
+    printf("                         Every line of the file is: <degree> <solution> <txt|svg> <output file>.\n");
+    printf("       -r <File name>    Renders the curve to the pgm image (ppm if the file name ends with .ppm) without calculating all points.\n");
+    printf("                         If the cells of the curve are smaller than the pixels, every pixel is colored by the position\n");
+    printf("                         along the curve of the first point it covers, which takes 4 more bytes per pixel.\n");
+    printf("       --size <W>x<H>    Size of the rendered image. By default 1024x1024.\n");
+    printf("       --verify          Cross-checks the solutions for the degree from -n without writing files: hashes the points,\n");
+    printf("                         checks that every step is a unit move and the curve is closed, and compares the hashes\n");
+    printf("                         with the iterative solution. With -V only the given solution is checked.\n");
+    printf("       --knn [<Points>] [<Queries>] [<K>] [<Window>] [<Curves>]\n");
+    printf("                         Builds the index of random points of the grid 2^n x 2^n sorted along shifted moore curves\n");
+    printf("                         and compares the approximate kNN and radius queries with the brute force search.\n");
+    printf("                         Uses the degree from -n (10 by default, at most 14).\n");
+    printf("       --encode <File>   Stores the curve of the degree from -n as its first point and 2 bit steps.\n");
+    printf("       --encode-points <Points file> <File>\n");
+    printf("                         Stores the points \"x, y\" of the text file sorted along the curve of the degree from -n\n");
+    printf("                         as the gaps between their moore indexes in group varint. The order of the points is not kept.\n");
+    printf("       --decode <File>   Decodes the compressed file of any mode to the text file from -o.\n");
     printf("       -h, --help        Shows help message and exits the program.\n");
 }
\ No newline at end of file
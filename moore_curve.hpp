@@ -0,0 +1,418 @@
+#ifndef MOORE_CURVE_HPP
+#define MOORE_CURVE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+/*
+ * Header-only C++17 front-end of the moore curve solutions.
+ *
+ * The degree is a template parameter, so the tables of the iterative solution and the points of small degrees
+ * are calculated at compile time, and the loops of the solutions are specialized for every degree that is used.
+ */
+namespace moore_curve {
+
+/*
+ * Maximum degree supported by the C solutions
+ */
+constexpr unsigned MAX_DEGREE = 15;
+
+/*
+ * Maximum degree for which the whole table of points can be built at compile time
+ */
+constexpr unsigned MAX_TABLE_DEGREE = 6;
+
+/*
+ * Calculates the commands count for the current degree
+ */
+constexpr int32_t commands_count(unsigned degree) {
+    if (degree == 0) return 0;
+    return ((1 << (2 * degree)) - 1) / 3 * 7;
+}
+
+/*
+ * Calculates the points count of the moore curve for the current degree
+ */
+constexpr std::size_t points_count(unsigned degree) {
+    return std::size_t(1) << (2 * degree);
+}
+
+template <class Coord>
+struct Point {
+    Coord x;
+    Coord y;
+
+    friend constexpr bool operator==(const Point& lhs, const Point& rhs) {
+        return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+
+    friend constexpr bool operator!=(const Point& lhs, const Point& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+namespace detail {
+
+/*
+ * Obtains the coordinates of the vertex in the Hilbert's curve of degree N from its gray code
+ *
+ * Same as init_coordinates and transform_to_hilbert from moore_curve_gray_code.c
+ */
+template <unsigned N>
+constexpr void gray_to_hilbert(uint32_t gray_number, uint32_t& xs, uint32_t& ys) {
+    xs = 0;
+    ys = 0;
+    for (unsigned i = 0; i < N; i++) {
+        xs |= ((gray_number >> (2 * i + 1)) & 1u) << i;
+        ys |= ((gray_number >> (2 * i)) & 1u) << i;
+    }
+
+    for (unsigned i = 1; i < N; i++) {
+        const uint32_t mask = (1u << i) - 1;
+        if ((ys >> i) & 1u) {
+            xs ^= mask;
+        } else {
+            const uint32_t swapped = (xs ^ ys) & mask;
+            xs ^= swapped;
+            ys ^= swapped;
+        }
+        if ((xs >> i) & 1u) {
+            xs ^= mask;
+        }
+    }
+}
+
+/*
+ * Indexes of the first occurrences of l(i) and r(i) in the string of commands
+ */
+template <unsigned Degree>
+struct FunctionsStarts {
+    std::array<int32_t, Degree + 1> l_commands_start{};
+    std::array<int32_t, Degree + 1> r_commands_start{};
+};
+
+/*
+ * Function calculates from which position the functions l(i) and r(i) begin
+ *
+ * Same as init_functions_starts from moore_curve_fast.c, but evaluated at compile time.
+ */
+template <unsigned Degree>
+constexpr FunctionsStarts<Degree> init_functions_starts() {
+    FunctionsStarts<Degree> starts{};
+    bool l_is_first = Degree % 2;
+    for (unsigned i = 1; i <= Degree; i++) {
+        const int32_t first_start = Degree - i;
+        const int32_t second_start = first_start + commands_count(i) + 2;
+        if (l_is_first) {
+            starts.l_commands_start[i] = first_start;
+            starts.r_commands_start[i] = second_start;
+        } else {
+            starts.l_commands_start[i] = second_start;
+            starts.r_commands_start[i] = first_start;
+        }
+        l_is_first = !l_is_first;
+    }
+    return starts;
+}
+
+/*
+ * Starts of l(i) and r(i) for the string of commands of the degree Degree (it is built with functions of Degree - 1)
+ */
+template <unsigned Degree>
+inline constexpr FunctionsStarts<Degree - 1> functions_starts = init_functions_starts<Degree - 1>();
+
+/*
+ * Size of the string of commands of the moore curve of degree Degree
+ */
+template <unsigned Degree>
+inline constexpr std::size_t commands_size = 4 * std::size_t(commands_count(Degree - 1)) + 5;
+
+inline void copy_commands(char* commands, int32_t count, int32_t from, int32_t to) {
+    for (int32_t i = 0; i < count; i++) {
+        commands[to + i] = commands[from + i];
+    }
+}
+
+/*
+ * Writes l(degree) −RF+LFL+FR− or r(degree) +LF−RFR−FL+ by copying the first written l(degree - 1) and r(degree - 1)
+ *
+ * Same as calc_l and calc_r from moore_curve_fast.c.
+ */
+template <unsigned Degree>
+void write_function(char* commands, unsigned degree, bool is_l) {
+    constexpr const FunctionsStarts<Degree - 1>& starts = functions_starts<Degree>;
+    const int32_t previous_count = commands_count(degree - 1);
+    const int32_t l_previous = starts.l_commands_start[degree - 1];
+    const int32_t r_previous = starts.r_commands_start[degree - 1];
+    // l(degree) starts with r(degree - 1) and r(degree) starts with l(degree - 1)
+    const int32_t outer = is_l ? r_previous : l_previous;
+    const int32_t inner = is_l ? l_previous : r_previous;
+    const char outer_turn = is_l ? '-' : '+';
+    const char inner_turn = is_l ? '+' : '-';
+
+    int32_t index = is_l ? starts.l_commands_start[degree] : starts.r_commands_start[degree];
+    commands[index++] = outer_turn;
+    if (index != outer) copy_commands(commands, previous_count, outer, index);
+    index += previous_count;
+    commands[index++] = 'F';
+    commands[index++] = inner_turn;
+    if (index != inner) copy_commands(commands, previous_count, inner, index);
+    index += previous_count;
+    commands[index++] = 'F';
+    copy_commands(commands, previous_count, inner, index);
+    index += previous_count;
+    commands[index++] = inner_turn;
+    commands[index++] = 'F';
+    copy_commands(commands, previous_count, outer, index);
+    index += previous_count;
+    commands[index] = outer_turn;
+}
+
+/*
+ * Writes the string of commands of the axiom LFL+F+LFL
+ *
+ * Same as calc_axiom from moore_curve_fast.c. The bounds of the loop and the starts of the functions are constants.
+ */
+template <unsigned Degree>
+void write_commands(char* commands) {
+    constexpr unsigned n = Degree - 1;
+    constexpr int32_t count = commands_count(n);
+    constexpr int32_t l_start = functions_starts<Degree>.l_commands_start[n];
+
+    for (unsigned i = 1; i < n; i++) {
+        write_function<Degree>(commands, i, true);
+        write_function<Degree>(commands, i, false);
+    }
+    if (n >= 1) {
+        write_function<Degree>(commands, n, true); // the first L of the axiom
+    }
+
+    int32_t index = count;
+    commands[index++] = 'F';
+    copy_commands(commands, count, l_start, index);
+    index += count;
+    commands[index++] = '+';
+    commands[index++] = 'F';
+    commands[index++] = '+';
+    copy_commands(commands, count, l_start, index);
+    index += count;
+    commands[index++] = 'F';
+    copy_commands(commands, count, l_start, index);
+}
+
+/*
+ * Processes the commands +, - and F and writes the points to the arrays
+ *
+ * Same as process_commands from moore_curve_fast.c.
+ */
+template <unsigned Degree, class Coord>
+void process_commands(const char* commands, Coord* x, Coord* y) {
+    // UP, RIGHT, DOWN, LEFT
+    constexpr int delta_x[4] = {0, 1, 0, -1};
+    constexpr int delta_y[4] = {1, 0, -1, 0};
+
+    Coord current_x = Coord((uint32_t(1) << (Degree - 1)) - 1);
+    Coord current_y = 0;
+    unsigned direction = 0;
+    std::size_t point_index = 0;
+    x[point_index] = current_x;
+    y[point_index++] = current_y;
+    for (std::size_t i = 0; i < commands_size<Degree>; i++) {
+        switch (commands[i]) {
+            case '+': direction = (direction + 1) & 3; break;
+            case '-': direction = (direction + 3) & 3; break;
+            case 'F':
+                current_x = Coord(current_x + delta_x[direction]);
+                current_y = Coord(current_y + delta_y[direction]);
+                x[point_index] = current_x;
+                y[point_index++] = current_y;
+                break;
+        }
+    }
+}
+
+} // namespace detail
+
+/*
+ * Returns the point of the moore curve of degree Degree with the given index
+ *
+ * Same as get_coordinates from moore_curve_gray_code.c. All loops have compile-time bounds.
+ */
+template <unsigned Degree, class Coord = uint32_t>
+constexpr Point<Coord> point_at(std::size_t index) {
+    static_assert(Degree >= 1 && Degree <= MAX_DEGREE, "Moore curve degree must be between 1 and 15");
+
+    constexpr unsigned n = Degree - 1;
+    constexpr uint32_t k = uint32_t(1) << n;
+    const uint32_t orig_number = uint32_t(index) & ((uint32_t(1) << (2 * n)) - 1);
+    const uint32_t quadrant = uint32_t(index >> (2 * n)) & 3u;
+
+    uint32_t xs = 0;
+    uint32_t ys = 0;
+    detail::gray_to_hilbert<n>(orig_number ^ (orig_number >> 1), xs, ys);
+
+    // transforms the Hilbert's curve of degree (n - 1) into one of the 4 quarters of the moore curve
+    switch (quadrant) {
+        case 0: return {Coord((k - 1) - ys), Coord(xs)};
+        case 1: return {Coord((k - 1) - ys), Coord(xs + k)};
+        case 2: return {Coord(ys + k), Coord((k - 1) - xs + k)};
+        default: return {Coord(ys + k), Coord((k - 1) - xs)};
+    }
+}
+
+/*
+ * Builds the table of all points of the moore curve at compile time
+ */
+template <unsigned Degree, class Coord>
+constexpr std::array<Point<Coord>, points_count(Degree)> make_points_table() {
+    static_assert(Degree <= MAX_TABLE_DEGREE, "Points table is too big to be built at compile time");
+
+    std::array<Point<Coord>, points_count(Degree)> table{};
+    for (std::size_t i = 0; i < table.size(); i++) {
+        table[i] = point_at<Degree, Coord>(i);
+    }
+    return table;
+}
+
+template <unsigned Degree, class Coord = uint32_t>
+inline constexpr std::array<Point<Coord>, points_count(Degree)> points_table = make_points_table<Degree, Coord>();
+
+/*
+ * Generator of the points of the moore curve of degree Degree
+ *
+ * Can be used in range-for loops and with STL algorithms:
+ *     for (auto point : moore_curve::Curve<5>()) { ... }
+ *
+ * Points are calculated lazily. For small degrees they are taken from the compile-time table.
+ */
+template <unsigned Degree, class Coord = uint32_t>
+class Curve {
+    static_assert(Degree >= 1 && Degree <= MAX_DEGREE, "Moore curve degree must be between 1 and 15");
+    static_assert(std::is_integral<Coord>::value, "Coordinate type must be integral");
+    static_assert(sizeof(Coord) * 8 >= Degree + (std::is_signed<Coord>::value ? 1 : 0),
+                  "Coordinate type is too small for the curve degree");
+
+public:
+    using value_type = Point<Coord>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr unsigned degree = Degree;
+
+    /*
+     * Iterator over the points of the curve
+     *
+     * Points are calculated on dereference and returned by value, so the iterator is declared as an input iterator,
+     * though it supports the arithmetic of random access iterators.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Point<Coord>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Point<Coord>;
+
+        constexpr iterator() = default;
+
+        constexpr explicit iterator(std::size_t index) : index_(index) {}
+
+        constexpr reference operator*() const { return Curve::at(index_); }
+
+        constexpr reference operator[](difference_type offset) const { return Curve::at(index_ + offset); }
+
+        constexpr iterator& operator++() { ++index_; return *this; }
+
+        constexpr iterator operator++(int) { iterator copy = *this; ++index_; return copy; }
+
+        constexpr iterator& operator--() { --index_; return *this; }
+
+        constexpr iterator operator--(int) { iterator copy = *this; --index_; return copy; }
+
+        constexpr iterator& operator+=(difference_type offset) { index_ += offset; return *this; }
+
+        constexpr iterator& operator-=(difference_type offset) { index_ -= offset; return *this; }
+
+        friend constexpr iterator operator+(iterator it, difference_type offset) { return it += offset; }
+
+        friend constexpr iterator operator+(difference_type offset, iterator it) { return it += offset; }
+
+        friend constexpr iterator operator-(iterator it, difference_type offset) { return it -= offset; }
+
+        friend constexpr difference_type operator-(const iterator& lhs, const iterator& rhs) {
+            return difference_type(lhs.index_) - difference_type(rhs.index_);
+        }
+
+        friend constexpr bool operator==(const iterator& lhs, const iterator& rhs) { return lhs.index_ == rhs.index_; }
+
+        friend constexpr bool operator!=(const iterator& lhs, const iterator& rhs) { return lhs.index_ != rhs.index_; }
+
+        friend constexpr bool operator<(const iterator& lhs, const iterator& rhs) { return lhs.index_ < rhs.index_; }
+
+        friend constexpr bool operator>(const iterator& lhs, const iterator& rhs) { return lhs.index_ > rhs.index_; }
+
+        friend constexpr bool operator<=(const iterator& lhs, const iterator& rhs) { return lhs.index_ <= rhs.index_; }
+
+        friend constexpr bool operator>=(const iterator& lhs, const iterator& rhs) { return lhs.index_ >= rhs.index_; }
+
+    private:
+        std::size_t index_ = 0;
+    };
+
+    using const_iterator = iterator;
+
+    /*
+     * Returns the point with the given index
+     */
+    static constexpr value_type at(std::size_t index) {
+        if constexpr (Degree <= MAX_TABLE_DEGREE) {
+            return points_table<Degree, Coord>[index];
+        } else {
+            return point_at<Degree, Coord>(index);
+        }
+    }
+
+    static constexpr size_type size() { return points_count(Degree); }
+
+    constexpr value_type operator[](std::size_t index) const { return at(index); }
+
+    constexpr iterator begin() const { return iterator(0); }
+
+    constexpr iterator end() const { return iterator(size()); }
+
+    /*
+     * Writes all points to the arrays x and y like the C solutions do
+     *
+     * Small degrees are copied from the compile-time table. Bigger degrees build the string of commands
+     * of the iterative solution from the compile-time starts of l(i) and r(i) and process it.
+     * Throws std::bad_alloc if the string of commands can not be allocated.
+     */
+    static void generate(Coord* x, Coord* y) {
+        if constexpr (Degree <= MAX_TABLE_DEGREE) {
+            for (std::size_t i = 0; i < size(); i++) {
+                x[i] = points_table<Degree, Coord>[i].x;
+                y[i] = points_table<Degree, Coord>[i].y;
+            }
+        } else {
+            const std::unique_ptr<char[]> commands(new char[detail::commands_size<Degree>]);
+            detail::write_commands<Degree>(commands.get());
+            detail::process_commands<Degree, Coord>(commands.get(), x, y);
+        }
+    }
+};
+
+/*
+ * Method finds points coordinates of the moore curve of degree Degree
+ */
+template <unsigned Degree, class Coord>
+void moore(Coord* x, Coord* y) {
+    Curve<Degree, Coord>::generate(x, y);
+}
+
+} // namespace moore_curve
+
+#endif // MOORE_CURVE_HPP
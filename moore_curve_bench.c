@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "moore_curve_reorder.h"
+
+#define MIN_MEASURE_TIME 0.1
+#define MEASURE_REPETITIONS 5
+#define MAX_RESULTS 64
+#define KERNEL_NAME_SIZE 32
+#define BENCH_TILE_SIZE 16
+
+typedef uint32_t coord_t;
+
+/*
+ * Result of one kernel. Time is the minimum over all repetitions
+ */
+struct BenchResult {
+    char name[KERNEL_NAME_SIZE];
+    int level; // degree of the l(i) and r(i) for per level kernels, otherwise -1
+    long iterations;
+    double ns_per_call;
+    double bytes_per_call;
+    double points_per_call;
+};
+
+/*
+ * Arguments of the kernels. Buffers are prepared once for the benchmarked degree
+ */
+struct BenchContext {
+    unsigned degree;
+    int level;
+    char* commands;
+    int32_t commands_size;
+    char* copy_buffer;
+    int32_t* l_commands_start;
+    int32_t* r_commands_start;
+    coord_t* x;
+    coord_t* y;
+    coord_t* gray_xs;
+    coord_t* gray_ys;
+    size_t points_number;
+    FILE* null_file;
+};
+
+typedef void (*kernel_t)(struct BenchContext* context);
+
+int32_t commands_count(unsigned degree);
+
+void copy_commands(unsigned degree, char* commands, const int32_t from, const int32_t to);
+
+void calc_l(unsigned degree, char* commands, int32_t* l_commands_start, int32_t* r_commands_start);
+
+void calc_r(unsigned degree, char* commands, int32_t* l_commands_start, int32_t* r_commands_start);
+
+void calc_axiom(unsigned degree, char* commands, int32_t* l_commands_start, int32_t* r_commands_start);
+
+void process_commands(unsigned degree, const int32_t n, const char* commands, coord_t* x, coord_t* y);
+
+void get_coordinates(coord_t* x_ptr, coord_t* y_ptr, size_t vertex_number, int moore_n);
+
+void init_coordinates(coord_t* xs, coord_t* ys, size_t gray_number, int n);
+
+void transform_to_hilbert(coord_t* xs, coord_t* ys, int n);
+
+void moore_walker(unsigned degree, coord_t* x, coord_t* y);
+
+void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y);
+
+
+/*
+ * Prevents the compiler from removing the calculation of the value pointed by [pointer]
+ */
+static inline void do_not_optimize(const void* pointer) {
+    __asm__ volatile("" : : "g"(pointer) : "memory");
+}
+
+double now() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+void kernel_copy_commands(struct BenchContext* context) {
+    copy_commands(context->level, context->copy_buffer, 0, commands_count(context->level));
+    do_not_optimize(context->copy_buffer);
+}
+
+void kernel_calc_l(struct BenchContext* context) {
+    calc_l(context->level, context->commands, context->l_commands_start, context->r_commands_start);
+    do_not_optimize(context->commands);
+}
+
+void kernel_calc_r(struct BenchContext* context) {
+    calc_r(context->level, context->commands, context->l_commands_start, context->r_commands_start);
+    do_not_optimize(context->commands);
+}
+
+void kernel_process_commands(struct BenchContext* context) {
+    process_commands(context->degree, context->commands_size, context->commands, context->x, context->y);
+    do_not_optimize(context->x);
+    do_not_optimize(context->y);
+}
+
+void kernel_get_coordinates(struct BenchContext* context) {
+    for (size_t i = 0; i < context->points_number; i++) {
+        get_coordinates(&context->x[i], &context->y[i], i, context->degree);
+    }
+    do_not_optimize(context->x);
+    do_not_optimize(context->y);
+}
+
+void kernel_moore_walker(struct BenchContext* context) {
+    moore_walker(context->degree, context->x, context->y);
+    do_not_optimize(context->x);
+    do_not_optimize(context->y);
+}
+
+void kernel_transform_to_hilbert(struct BenchContext* context) {
+    const size_t hilbert_points_number = context->points_number / 4;
+    for (size_t i = 0; i < hilbert_points_number; i++) {
+        context->x[i] = context->gray_xs[i];
+        context->y[i] = context->gray_ys[i];
+        transform_to_hilbert(&context->x[i], &context->y[i], context->degree - 1);
+    }
+    do_not_optimize(context->x);
+    do_not_optimize(context->y);
+}
+
+/*
+ * The x buffer is reordered as the 2^degree x 2^degree array to the y buffer on one thread
+ */
+void kernel_moore_reorder(struct BenchContext* context) {
+    const int side = 1 << context->degree;
+    moore_reorder(context->x, context->y, side, side, sizeof(coord_t), BENCH_TILE_SIZE, 1);
+    do_not_optimize(context->y);
+}
+
+void kernel_moore_restore(struct BenchContext* context) {
+    const int side = 1 << context->degree;
+    moore_restore(context->y, context->x, side, side, sizeof(coord_t), BENCH_TILE_SIZE, 1);
+    do_not_optimize(context->x);
+}
+
+void kernel_print_points(struct BenchContext* context) {
+    print_moore_curve_points(context->null_file, (int32_t) context->points_number, context->x, context->y);
+    fflush(context->null_file);
+}
+
+/*
+ * Method measures the kernel
+ *
+ * The number of iterations is doubled until one measurement takes MIN_MEASURE_TIME,
+ * then the fixed number of iterations is measured MEASURE_REPETITIONS times.
+ */
+void measure_kernel(struct BenchContext* context, kernel_t kernel, struct BenchResult* result) {
+    long iterations = 1;
+    for (;;) {
+        double start = now();
+        for (long i = 0; i < iterations; i++) {
+            kernel(context);
+        }
+        if (now() - start >= MIN_MEASURE_TIME || iterations >= (1L << 30)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double best_time = -1.0;
+    for (int repetition = 0; repetition < MEASURE_REPETITIONS; repetition++) {
+        double start = now();
+        for (long i = 0; i < iterations; i++) {
+            kernel(context);
+        }
+        double time = now() - start;
+        if (best_time < 0 || time < best_time) {
+            best_time = time;
+        }
+    }
+
+    result->iterations = iterations;
+    result->ns_per_call = 1e9 * best_time / iterations;
+}
+
+void add_result(struct BenchResult* results, int* results_count, struct BenchContext* context, kernel_t kernel,
+                const char* name, double bytes_per_call, double points_per_call) {
+    struct BenchResult* result = &results[(*results_count)++];
+    snprintf(result->name, KERNEL_NAME_SIZE, "%s", name);
+    result->level = context->level;
+    result->bytes_per_call = bytes_per_call;
+    result->points_per_call = points_per_call;
+    measure_kernel(context, kernel, result);
+}
+
+void print_results(FILE* fptr, const struct BenchResult* results, int results_count) {
+    fprintf(fptr, "%-20s %6s %12s %14s %12s %12s\n", "Kernel", "Level", "Iterations", "ns/call", "MB/s", "ns/point");
+    for (int i = 0; i < results_count; i++) {
+        const struct BenchResult* result = &results[i];
+        fprintf(fptr, "%-20s %6d %12ld %14.1f %12.1f", result->name, result->level, result->iterations,
+                result->ns_per_call, result->bytes_per_call / result->ns_per_call * 1e3);
+        if (result->points_per_call > 0) {
+            fprintf(fptr, " %12.3f\n", result->ns_per_call / result->points_per_call);
+        } else {
+            fprintf(fptr, " %12s\n", "-");
+        }
+    }
+}
+
+void print_results_json(FILE* fptr, unsigned degree, const struct BenchResult* results, int results_count) {
+    fprintf(fptr, "{\n  \"degree\": %u,\n  \"kernels\": [\n", degree);
+    for (int i = 0; i < results_count; i++) {
+        const struct BenchResult* result = &results[i];
+        fprintf(fptr, "    {\"name\": \"%s\", \"level\": %d, \"iterations\": %ld, \"ns_per_call\": %.3f, "
+                      "\"bytes_per_second\": %.1f, \"ns_per_point\": %.6f}%s\n",
+                result->name, result->level, result->iterations, result->ns_per_call,
+                result->bytes_per_call / result->ns_per_call * 1e9,
+                result->points_per_call > 0 ? result->ns_per_call / result->points_per_call : 0.0,
+                i + 1 < results_count ? "," : "");
+    }
+    fprintf(fptr, "  ]\n}\n");
+}
+
+/*
+ * Returns the number of bytes written by print_moore_curve_points
+ */
+double printed_points_size(struct BenchContext* context) {
+    double size = 0;
+    char line[32];
+    for (size_t i = 0; i < context->points_number; i++) {
+        size += snprintf(line, sizeof(line), "%d, %d\n", context->x[i], context->y[i]);
+    }
+    return size;
+}
+
+bool init_context(struct BenchContext* context, unsigned degree) {
+    memset(context, 0, sizeof(struct BenchContext));
+    context->degree = degree;
+    context->level = -1;
+    context->points_number = (size_t) 1 << (2 * degree);
+    context->commands_size = 4 * commands_count(degree - 1) + 5;
+    context->commands = (char*) malloc(context->commands_size);
+    context->copy_buffer = (char*) malloc(2 * (size_t) commands_count(degree - 1) + 1);
+    context->l_commands_start = (int32_t*) malloc(sizeof(int32_t) * (degree + 1));
+    context->r_commands_start = (int32_t*) malloc(sizeof(int32_t) * (degree + 1));
+    context->x = (coord_t*) malloc(sizeof(coord_t) * context->points_number);
+    context->y = (coord_t*) malloc(sizeof(coord_t) * context->points_number);
+    context->gray_xs = (coord_t*) malloc(sizeof(coord_t) * context->points_number / 4);
+    context->gray_ys = (coord_t*) malloc(sizeof(coord_t) * context->points_number / 4);
+    context->null_file = fopen("/dev/null", "w");
+    if (context->commands == NULL || context->copy_buffer == NULL || context->l_commands_start == NULL
+            || context->r_commands_start == NULL || context->x == NULL || context->y == NULL
+            || context->gray_xs == NULL || context->gray_ys == NULL || context->null_file == NULL) {
+        return false;
+    }
+
+    calc_axiom(degree, context->commands, context->l_commands_start, context->r_commands_start);
+    memset(context->copy_buffer, 'F', 2 * (size_t) commands_count(degree - 1) + 1);
+    for (size_t i = 0; i < context->points_number / 4; i++) {
+        init_coordinates(&context->gray_xs[i], &context->gray_ys[i], i ^ (i >> 1), degree - 1);
+    }
+    process_commands(degree, context->commands_size, context->commands, context->x, context->y);
+    return true;
+}
+
+void free_context(struct BenchContext* context) {
+    free(context->commands);
+    free(context->copy_buffer);
+    free(context->l_commands_start);
+    free(context->r_commands_start);
+    free(context->x);
+    free(context->y);
+    free(context->gray_xs);
+    free(context->gray_ys);
+    if (context->null_file != NULL) {
+        fclose(context->null_file);
+    }
+}
+
+void print_bench_help_message() {
+    printf("Usage: make bench\n./moore_curve_bench [-n <Number>] [--json <File name>]\n\n");
+    printf("Measures the kernels of the solutions separately.\n\n");
+    printf("       -n <Number>       Determines the degree N of the moore curve. By default 10.\n");
+    printf("       --json <File>     Writes the results to the file in json format.\n");
+    printf("       -h, --help        Shows help message and exits the program.\n");
+}
+
+int main(int argc, char* argv[]) {
+    int degree = 10;
+    const char* json_file = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc && isdigit(argv[i + 1][0])) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_file = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_bench_help_message();
+            return 0;
+        } else {
+            fprintf(stderr, "Specified argument is not supported\n");
+            return -1;
+        }
+    }
+    if (degree < 2 || degree > 15) {
+        fprintf(stderr, "Invalid moore curve degree. The number must be between 2 and 15\n");
+        return -1;
+    }
+
+    struct BenchContext context;
+    if (!init_context(&context, degree)) {
+        free_context(&context);
+        fprintf(stderr, "Failed memory allocation. Moore curve degree is too big\n");
+        return -1;
+    }
+
+    struct BenchResult results[MAX_RESULTS];
+    int results_count = 0;
+    for (int level = 1; level < degree; level++) {
+        context.level = level;
+        add_result(results, &results_count, &context, kernel_copy_commands, "copy_commands", commands_count(level), 0);
+    }
+    for (int level = 1; level < degree; level++) {
+        context.level = level;
+        add_result(results, &results_count, &context, kernel_calc_l, "calc_l", commands_count(level), 0);
+        add_result(results, &results_count, &context, kernel_calc_r, "calc_r", commands_count(level), 0);
+    }
+
+    // calc_r of the last level overwrites the axiom, so the commands are calculated again
+    context.level = -1;
+    calc_axiom(degree, context.commands, context.l_commands_start, context.r_commands_start);
+    const double points_size = 2 * sizeof(coord_t) * (double) context.points_number;
+    add_result(results, &results_count, &context, kernel_process_commands, "process_commands",
+               context.commands_size + points_size, context.points_number);
+    add_result(results, &results_count, &context, kernel_get_coordinates, "get_coordinates",
+               points_size, context.points_number);
+    add_result(results, &results_count, &context, kernel_moore_walker, "moore_walker",
+               points_size, context.points_number);
+    add_result(results, &results_count, &context, kernel_transform_to_hilbert, "transform_to_hilbert",
+               2 * points_size / 4, context.points_number / 4);
+    add_result(results, &results_count, &context, kernel_moore_reorder, "moore_reorder",
+               points_size, context.points_number);
+    add_result(results, &results_count, &context, kernel_moore_restore, "moore_restore",
+               points_size, context.points_number);
+    // Formatter needs the points of the curve, other kernels could overwrite them
+    process_commands(degree, context.commands_size, context.commands, context.x, context.y);
+    add_result(results, &results_count, &context, kernel_print_points, "print_points",
+               printed_points_size(&context), context.points_number);
+
+    print_results(stdout, results, results_count);
+    if (json_file != NULL) {
+        FILE* fptr = fopen(json_file, "w");
+        if (fptr == NULL) {
+            free_context(&context);
+            fprintf(stderr, "Failed to open the file %s\n", json_file);
+            return -1;
+        }
+        print_results_json(fptr, degree, results, results_count);
+        fclose(fptr);
+    }
+
+    free_context(&context);
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "moore_curve_cache.h"
+
+#define CACHE_MAGIC "MOORECRV"
+#define CACHE_MAGIC_SIZE 8
+#define CACHE_VERSION 2
+#define CACHE_PATH_SIZE 4096
+// Independent multiplication chains of the checksum
+#define CHECKSUM_LANES 4
+#define FNV_PRIME 0x100000001b3ULL
+
+// Layouts of the points in the payload
+#define CACHE_LAYOUT_SEPARATE_XY 0
+
+/*
+ * Header of the cache file
+ *
+ * The payload starts at the page aligned payload_offset. It contains all x coordinates followed by all y coordinates.
+ */
+struct CacheHeader {
+    char magic[CACHE_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t degree;
+    uint32_t layout;
+    uint32_t coord_size;
+    uint64_t points_number;
+    uint64_t payload_offset;
+    uint64_t x_offset;
+    uint64_t y_offset;
+    uint64_t checksum;
+};
+
+/*
+ * Calculates the checksum of the coordinates
+ *
+ * The coordinates are dealt to 4 lanes of FNV-1a, so the multiplications of the lanes do not wait for each other.
+ */
+uint64_t cache_checksum(const coord_t* coords, uint64_t count, uint64_t seed) {
+    uint64_t lanes[CHECKSUM_LANES] = {seed, seed + 1, seed + 2, seed + 3};
+    uint64_t i = 0;
+    for (; i + CHECKSUM_LANES <= count; i += CHECKSUM_LANES) {
+        for (int lane = 0; lane < CHECKSUM_LANES; lane++) {
+            lanes[lane] = (lanes[lane] ^ coords[i + lane]) * FNV_PRIME;
+        }
+    }
+    for (; i < count; i++) {
+        lanes[0] = (lanes[0] ^ coords[i]) * FNV_PRIME;
+    }
+
+    uint64_t hash = seed;
+    for (int lane = 0; lane < CHECKSUM_LANES; lane++) {
+        hash = (hash ^ lanes[lane]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/*
+ * Method writes the path of the cache file for the current degree to [path]
+ */
+bool cache_file_path(const char* cache_dir, unsigned degree, char* path) {
+    int written = snprintf(path, CACHE_PATH_SIZE, "%s/moore_curve_%u.bin", cache_dir, degree);
+    return written > 0 && written < CACHE_PATH_SIZE;
+}
+
+uint64_t align_to_page(uint64_t size) {
+    const uint64_t page_size = (uint64_t) sysconf(_SC_PAGESIZE);
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+/*
+ * Method fills the header of the cache file for the current degree
+ */
+void init_cache_header(struct CacheHeader* header, unsigned degree) {
+    memset(header, 0, sizeof(struct CacheHeader));
+    memcpy(header->magic, CACHE_MAGIC, CACHE_MAGIC_SIZE);
+    header->version = CACHE_VERSION;
+    header->degree = degree;
+    header->layout = CACHE_LAYOUT_SEPARATE_XY;
+    header->coord_size = sizeof(coord_t);
+    header->points_number = (uint64_t) 1 << (2 * degree);
+    header->payload_offset = align_to_page(sizeof(struct CacheHeader));
+    header->x_offset = header->payload_offset;
+    header->y_offset = header->x_offset + align_to_page(header->points_number * sizeof(coord_t));
+}
+
+bool write_fully(int fd, const void* data, uint64_t size, uint64_t offset) {
+    const char* bytes = (const char*) data;
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, (off_t) offset);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        offset += written;
+        size -= written;
+    }
+    return true;
+}
+
+/*
+ * Method saves points of the moore curve to the cache directory
+ *
+ * The file is written under a temporary name and renamed, so other processes never map a partially written file.
+ */
+bool store_cached_moore_curve(const char* cache_dir, unsigned degree, const coord_t* x, const coord_t* y) {
+    char path[CACHE_PATH_SIZE];
+    char temp_path[CACHE_PATH_SIZE];
+    if (!cache_file_path(cache_dir, degree, path)) {
+        return false;
+    }
+    int written = snprintf(temp_path, CACHE_PATH_SIZE, "%s.%ld.tmp", path, (long) getpid());
+    if (written <= 0 || written >= CACHE_PATH_SIZE) {
+        return false;
+    }
+
+    struct CacheHeader header;
+    init_cache_header(&header, degree);
+    header.checksum = cache_checksum(y, header.points_number, cache_checksum(x, header.points_number, degree));
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    const uint64_t coords_size = header.points_number * sizeof(coord_t);
+    bool success = write_fully(fd, &header, sizeof(struct CacheHeader), 0)
+            && write_fully(fd, x, coords_size, header.x_offset)
+            && write_fully(fd, y, coords_size, header.y_offset)
+            && ftruncate(fd, (off_t) align_to_page(header.y_offset + coords_size)) == 0;
+    success = close(fd) == 0 && success;
+
+    if (!success || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Method maps the cache file of the current degree read-only
+ *
+ * The header and the size of the file are validated, the pages of the payload are read on demand when the points
+ * are used. Files are written under a temporary name and renamed, so a partially written file is never mapped.
+ * The checksum of the whole payload is compared with the stored one only if verify_payload is set, because it reads
+ * every page before the first point is used. Returns false if the file is missing, was written by an incompatible
+ * version, is truncated or its payload does not match the checksum.
+ */
+bool load_cached_moore_curve(const char* cache_dir, unsigned degree, bool verify_payload, struct MooreCurveCache* cache) {
+    char path[CACHE_PATH_SIZE];
+    if (!cache_file_path(cache_dir, degree, path)) {
+        return false;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct CacheHeader expected;
+    struct CacheHeader header;
+    struct stat file_stat;
+    init_cache_header(&expected, degree);
+    if (pread(fd, &header, sizeof(struct CacheHeader), 0) != sizeof(struct CacheHeader) || fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // Everything except the checksum must be the same as in the header written by this version
+    expected.checksum = header.checksum;
+    const uint64_t mapping_size = header.y_offset + header.points_number * sizeof(coord_t);
+    if (memcmp(&expected, &header, sizeof(struct CacheHeader)) != 0 || (uint64_t) file_stat.st_size < mapping_size) {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const coord_t* x = (const coord_t*) ((char*) mapping + header.x_offset);
+    const coord_t* y = (const coord_t*) ((char*) mapping + header.y_offset);
+    if (verify_payload
+            && cache_checksum(y, header.points_number, cache_checksum(x, header.points_number, degree)) != header.checksum) {
+        munmap(mapping, mapping_size);
+        return false;
+    }
+
+    cache->mapping = mapping;
+    cache->mapping_size = mapping_size;
+    cache->x = (coord_t*) x;
+    cache->y = (coord_t*) y;
+    return true;
+}
+
+/*
+ * Method unmaps the cache file
+ */
+void unload_cached_moore_curve(struct MooreCurveCache* cache) {
+    if (cache->mapping != NULL) {
+        munmap(cache->mapping, cache->mapping_size);
+    }
+    cache->mapping = NULL;
+    cache->x = NULL;
+    cache->y = NULL;
+}
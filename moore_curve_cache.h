@@ -0,0 +1,26 @@
+#ifndef MOORE_CURVE_CACHE_H
+#define MOORE_CURVE_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t coord_t;
+
+/*
+ * Points of the moore curve mapped from the cache file
+ */
+struct MooreCurveCache {
+    void* mapping;
+    size_t mapping_size;
+    coord_t* x;
+    coord_t* y;
+};
+
+bool load_cached_moore_curve(const char* cache_dir, unsigned degree, bool verify_payload, struct MooreCurveCache* cache);
+
+bool store_cached_moore_curve(const char* cache_dir, unsigned degree, const coord_t* x, const coord_t* y);
+
+void unload_cached_moore_curve(struct MooreCurveCache* cache);
+
+#endif // MOORE_CURVE_CACHE_H
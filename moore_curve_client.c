@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "moore_curve_server.h"
+
+#define LOAD_TEST_CLIENTS 4
+
+/*
+ * Parameters and results of one client of the load test
+ */
+struct LoadTestClient {
+    const char* socket_path;
+    unsigned degree;
+    int requests_count;
+    uint32_t batch_size;
+    unsigned seed;
+    double* latencies;
+    int completed_requests;
+    int mismatches;
+    bool failed;
+};
+
+int connect_to_server(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(struct sockaddr_un));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*) &address, sizeof(struct sockaddr_un)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool client_read_fully(int fd, void* data, size_t size) {
+    char* bytes = (char*) data;
+    while (size > 0) {
+        ssize_t received = recv(fd, bytes, size, MSG_WAITALL);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) continue;
+            return false;
+        }
+        bytes += received;
+        size -= received;
+    }
+    return true;
+}
+
+bool client_send_fully(int fd, const void* data, size_t size) {
+    const char* bytes = (const char*) data;
+    while (size > 0) {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) continue;
+            return false;
+        }
+        bytes += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+/*
+ * Method sends the request and waits for the response. Returns the latency in seconds or -1 on failure
+ */
+double send_request(int fd, const struct ServerRequest* request, const void* payload, size_t payload_size,
+                    void* response_payload, size_t response_size) {
+    struct timespec start;
+    struct timespec end;
+    struct ServerResponse response;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!client_send_fully(fd, request, sizeof(struct ServerRequest)) || !client_send_fully(fd, payload, payload_size)
+            || !client_read_fully(fd, &response, sizeof(struct ServerResponse)) || response.status != STATUS_OK
+            || !client_read_fully(fd, response_payload, response_size)) {
+        return -1.0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+}
+
+/*
+ * Client converts random indexes to points and the points back to indexes, checking that the indexes are the same
+ */
+void* load_test_client(void* argument) {
+    struct LoadTestClient* client = (struct LoadTestClient*) argument;
+    const uint32_t points_mask = (uint32_t) (((uint64_t) 1 << (2 * client->degree)) - 1);
+
+    uint32_t* indexes = (uint32_t*) malloc(sizeof(uint32_t) * client->batch_size);
+    uint32_t* points = (uint32_t*) malloc(2 * sizeof(uint32_t) * client->batch_size);
+    uint32_t* result_indexes = (uint32_t*) malloc(sizeof(uint32_t) * client->batch_size);
+    int fd = connect_to_server(client->socket_path);
+    client->failed = fd < 0 || indexes == NULL || points == NULL || result_indexes == NULL;
+
+    for (int i = 0; i + 1 < client->requests_count && !client->failed; i += 2) {
+        for (uint32_t j = 0; j < client->batch_size; j++) {
+            indexes[j] = (uint32_t) rand_r(&client->seed) & points_mask;
+        }
+
+        struct ServerRequest to_points = {OPERATION_INDEX_TO_POINT, client->degree, client->batch_size};
+        double latency = send_request(fd, &to_points, indexes, sizeof(uint32_t) * client->batch_size,
+                                      points, 2 * sizeof(uint32_t) * client->batch_size);
+        client->latencies[client->completed_requests++] = latency;
+
+        struct ServerRequest to_indexes = {OPERATION_POINT_TO_INDEX, client->degree, client->batch_size};
+        double back_latency = send_request(fd, &to_indexes, points, 2 * sizeof(uint32_t) * client->batch_size,
+                                           result_indexes, sizeof(uint32_t) * client->batch_size);
+        client->latencies[client->completed_requests++] = back_latency;
+
+        client->failed = latency < 0 || back_latency < 0;
+        client->mismatches += memcmp(indexes, result_indexes, sizeof(uint32_t) * client->batch_size) != 0;
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(indexes);
+    free(points);
+    free(result_indexes);
+    return NULL;
+}
+
+int compare_latencies(const void* lhs, const void* rhs) {
+    const double lhs_latency = *(const double*) lhs;
+    const double rhs_latency = *(const double*) rhs;
+    return (lhs_latency > rhs_latency) - (lhs_latency < rhs_latency);
+}
+
+double latency_percentile(const double* latencies, int count, double percentile) {
+    int index = (int) (percentile * (count - 1));
+    return latencies[index];
+}
+
+/*
+ * Method measures QPS and latency of the daemon started with --serve
+ *
+ * Every client sends requests_count / LOAD_TEST_CLIENTS requests with batch_size points each.
+ */
+int load_test_moore_curve(const char* socket_path, unsigned degree, int requests_count, uint32_t batch_size) {
+    struct LoadTestClient clients[LOAD_TEST_CLIENTS];
+    pthread_t threads[LOAD_TEST_CLIENTS];
+    const int client_requests_count = requests_count / LOAD_TEST_CLIENTS;
+
+    double* latencies = (double*) malloc(sizeof(double) * client_requests_count * LOAD_TEST_CLIENTS);
+    if (latencies == NULL) {
+        return -1;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < LOAD_TEST_CLIENTS; i++) {
+        clients[i] = (struct LoadTestClient) {socket_path, degree, client_requests_count, batch_size, i + 1,
+                                              latencies + (size_t) i * client_requests_count, 0, 0, false};
+        pthread_create(&threads[i], NULL, load_test_client, &clients[i]);
+    }
+
+    int completed_requests = 0;
+    int mismatches = 0;
+    bool failed = false;
+    for (int i = 0; i < LOAD_TEST_CLIENTS; i++) {
+        pthread_join(threads[i], NULL);
+        failed |= clients[i].failed;
+        mismatches += clients[i].mismatches;
+        // Latencies of the clients are gathered to the beginning of the array
+        memmove(latencies + completed_requests, clients[i].latencies, sizeof(double) * clients[i].completed_requests);
+        completed_requests += clients[i].completed_requests;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double time = end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+
+    if (failed || completed_requests == 0) {
+        free(latencies);
+        return -1;
+    }
+
+    qsort(latencies, completed_requests, sizeof(double), compare_latencies);
+    printf("Requests: %d (%d points each, %d clients)\n", completed_requests, batch_size, LOAD_TEST_CLIENTS);
+    printf("Time: %f\n", time);
+    printf("QPS: %.0f\n", completed_requests / time);
+    printf("Points per second: %.0f\n", (double) completed_requests * batch_size / time);
+    printf("Latency p50: %.2f us\n", 1e6 * latency_percentile(latencies, completed_requests, 0.5));
+    printf("Latency p99: %.2f us\n", 1e6 * latency_percentile(latencies, completed_requests, 0.99));
+    printf("Latency p99.9: %.2f us\n", 1e6 * latency_percentile(latencies, completed_requests, 0.999));
+    printf("Latency max: %.2f us\n", 1e6 * latencies[completed_requests - 1]);
+    printf("Mismatched batches: %d\n", mismatches);
+
+    free(latencies);
+    return mismatches == 0 ? 0 : -1;
+}
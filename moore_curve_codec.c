@@ -0,0 +1,545 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "moore_curve_codec.h"
+#include "moore_curve_knn.h"
+
+#define CODEC_MAGIC "MOORECDC"
+#define CODEC_MAGIC_SIZE 8
+#define CODEC_VERSION 1
+// Generated curve: the first point and 2 bits per step
+#define CODEC_MODE_STEPS 0
+// Sorted points: gaps between the moore indexes of the points in group varint
+#define CODEC_MODE_KEYS 1
+#define STEPS_PER_BYTE 4
+#define GROUP_SIZE 4
+// Group varint decoder reads 4 bytes for every value, so the payload is followed by this many zero bytes
+#define PAYLOAD_PADDING 4
+// Bytes of the step stream decoded together, the offsets of their points stay in L1
+#define STEPS_BLOCK_BYTES 256
+// Indexes converted to points together, the coordinates of the batch stay in L1
+#define KEYS_BATCH_SIZE 1024
+
+typedef uint32_t coord_t;
+
+/*
+ * Header of the compressed file. The payload follows the header
+ */
+struct CodecHeader {
+    char magic[CODEC_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t mode;
+    uint32_t degree;
+    uint32_t reserved;
+    uint64_t points_number;
+    uint64_t payload_size;
+    coord_t first_x;
+    coord_t first_y;
+};
+
+/*
+ * Lengths in bytes of the 4 values of the group described by the control byte
+ */
+struct GroupEntry {
+    uint8_t lengths[GROUP_SIZE];
+    uint8_t size;
+};
+
+/*
+ * Points decoded from the compressed file
+ */
+struct DecodedPoints {
+    unsigned degree;
+    size_t count;
+    coord_t* x;
+    coord_t* y;
+};
+
+static const uint32_t length_masks[5] = {0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+double calc_moore_curve_points(unsigned degree, coord_t* x, coord_t* y, int solution_type, bool with_benchmarking);
+
+bool malloc_is_failed();
+
+coord_t* allocate_coords(size_t count);
+
+void free_coords(coord_t* coords, size_t count);
+
+size_t get_index(coord_t x, coord_t y, int moore_n);
+
+void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y);
+
+
+// Step codes: 0 is +x, 1 is +y, 2 is -x, 3 is -y
+static inline coord_t step_code_dx(coord_t code) {
+    return (1 - code) & -(~code & 1);
+}
+
+static inline coord_t step_code_dy(coord_t code) {
+    return (2 - code) & -(code & 1);
+}
+
+/*
+ * Sum of the 4 steps packed into every byte
+ */
+void init_moves_table(int8_t* moves_x, int8_t* moves_y) {
+    for (int byte = 0; byte < 256; byte++) {
+        coord_t dx = 0;
+        coord_t dy = 0;
+        for (int step = 0; step < STEPS_PER_BYTE; step++) {
+            dx += step_code_dx((byte >> (2 * step)) & 3);
+            dy += step_code_dy((byte >> (2 * step)) & 3);
+        }
+        moves_x[byte] = (int8_t) dx;
+        moves_y[byte] = (int8_t) dy;
+    }
+}
+
+void init_group_table(struct GroupEntry* table) {
+    for (int control = 0; control < 256; control++) {
+        table[control].size = 0;
+        for (int value = 0; value < GROUP_SIZE; value++) {
+            table[control].lengths[value] = ((control >> (2 * value)) & 3) + 1;
+            table[control].size += table[control].lengths[value];
+        }
+    }
+}
+
+void init_codec_header(struct CodecHeader* header, uint32_t mode, unsigned degree, size_t points_number) {
+    memset(header, 0, sizeof(struct CodecHeader));
+    memcpy(header->magic, CODEC_MAGIC, CODEC_MAGIC_SIZE);
+    header->version = CODEC_VERSION;
+    header->mode = mode;
+    header->degree = degree;
+    header->points_number = points_number;
+}
+
+bool write_codec_file(const char* file_name, const struct CodecHeader* header, const uint8_t* payload) {
+    FILE* fptr = fopen(file_name, "wb");
+    if (fptr == NULL) {
+        return false;
+    }
+    bool is_written = fwrite(header, sizeof(struct CodecHeader), 1, fptr) == 1
+            && fwrite(payload, 1, header->payload_size, fptr) == header->payload_size;
+    return fclose(fptr) == 0 && is_written;
+}
+
+/*
+ * Method stores the curve as its first point and the packed 2 bit codes of its steps
+ *
+ * Returns false if some step is not a unit move or the file can not be written.
+ */
+bool encode_moore_steps(const char* file_name, unsigned degree, const coord_t* x, const coord_t* y, size_t points_number) {
+    struct CodecHeader header;
+    init_codec_header(&header, CODEC_MODE_STEPS, degree, points_number);
+    header.first_x = x[0];
+    header.first_y = y[0];
+    header.payload_size = (points_number - 1 + STEPS_PER_BYTE - 1) / STEPS_PER_BYTE;
+    uint8_t* payload = (uint8_t*) calloc(header.payload_size + 1, 1);
+    if (payload == NULL) {
+        return false;
+    }
+
+    for (size_t i = 1; i < points_number; i++) {
+        const int64_t dx = (int64_t) x[i] - x[i - 1];
+        const int64_t dy = (int64_t) y[i] - y[i - 1];
+        int code;
+        if (dx == 1 && dy == 0) {
+            code = 0;
+        } else if (dx == 0 && dy == 1) {
+            code = 1;
+        } else if (dx == -1 && dy == 0) {
+            code = 2;
+        } else if (dx == 0 && dy == -1) {
+            code = 3;
+        } else {
+            free(payload);
+            return false;
+        }
+        payload[(i - 1) / STEPS_PER_BYTE] |= code << (2 * ((i - 1) % STEPS_PER_BYTE));
+    }
+
+    bool is_written = write_codec_file(file_name, &header, payload);
+    free(payload);
+    return is_written;
+}
+
+/*
+ * Method stores the points sorted by their moore indexes. Gaps between the indexes are written in group varint:
+ * a control byte with 2 bit lengths of 4 gaps, followed by the gaps in 1 to 4 bytes.
+ *
+ * The order of the points is not kept. Returns false if the memory can not be allocated or the file can not be written.
+ */
+bool encode_moore_keys(const char* file_name, unsigned degree, const coord_t* x, const coord_t* y, size_t count) {
+    const size_t groups_count = (count + GROUP_SIZE - 1) / GROUP_SIZE;
+    uint32_t* keys = (uint32_t*) malloc(sizeof(uint32_t) * groups_count * GROUP_SIZE);
+    uint32_t* ids = (uint32_t*) malloc(sizeof(uint32_t) * count);
+    uint8_t* payload = (uint8_t*) malloc(groups_count * (1 + GROUP_SIZE * sizeof(uint32_t)));
+    if (keys == NULL || ids == NULL || payload == NULL) {
+        free(keys);
+        free(ids);
+        free(payload);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = (uint32_t) get_index(x[i], y[i], degree);
+        ids[i] = (uint32_t) i;
+    }
+    if (!radix_sort_keys(keys, ids, count, 2 * degree)) {
+        free(keys);
+        free(ids);
+        free(payload);
+        return false;
+    }
+    // Gaps of the last group are padded with zeros
+    for (size_t i = count; i < groups_count * GROUP_SIZE; i++) {
+        keys[i] = keys[count - 1];
+    }
+
+    size_t size = 0;
+    uint32_t previous_key = 0;
+    for (size_t group = 0; group < groups_count; group++) {
+        uint8_t* control = &payload[size++];
+        *control = 0;
+        for (int value = 0; value < GROUP_SIZE; value++) {
+            const uint32_t key = keys[group * GROUP_SIZE + value];
+            const uint32_t gap = key - previous_key;
+            previous_key = key;
+            const int length = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+            *control |= (length - 1) << (2 * value);
+            for (int byte = 0; byte < length; byte++) {
+                payload[size++] = (uint8_t) (gap >> (8 * byte));
+            }
+        }
+    }
+
+    struct CodecHeader header;
+    init_codec_header(&header, CODEC_MODE_KEYS, degree, count);
+    header.payload_size = size;
+    bool is_written = write_codec_file(file_name, &header, payload);
+    free(keys);
+    free(ids);
+    free(payload);
+    return is_written;
+}
+
+/*
+ * Method decodes the step stream by blocks of bytes in 2 passes. The first pass is the only loop-carried dependency:
+ * it adds up the moves of whole bytes from the table to find the point before every byte, one addition per 4 points.
+ * The second pass adds the prefix sums of the steps inside the byte to that point. The codes are turned to the steps
+ * by arithmetic instead of a table, so the 4 points of the byte are independent and the loop is vectorized.
+ */
+void decode_steps(const struct CodecHeader* header, const uint8_t* payload, coord_t* x, coord_t* y) {
+    int8_t moves_x[256];
+    int8_t moves_y[256];
+    init_moves_table(moves_x, moves_y);
+    coord_t bases_x[STEPS_BLOCK_BYTES];
+    coord_t bases_y[STEPS_BLOCK_BYTES];
+
+    coord_t current_x = header->first_x;
+    coord_t current_y = header->first_y;
+    x[0] = current_x;
+    y[0] = current_y;
+    const size_t steps_count = header->points_number - 1;
+    const size_t full_bytes = steps_count / STEPS_PER_BYTE;
+    for (size_t first_byte = 0; first_byte < full_bytes; first_byte += STEPS_BLOCK_BYTES) {
+        const size_t bytes_count = full_bytes - first_byte < STEPS_BLOCK_BYTES ? full_bytes - first_byte : STEPS_BLOCK_BYTES;
+        const uint8_t* codes = payload + first_byte;
+        for (size_t byte = 0; byte < bytes_count; byte++) {
+            bases_x[byte] = current_x;
+            bases_y[byte] = current_y;
+            current_x += moves_x[codes[byte]];
+            current_y += moves_y[codes[byte]];
+        }
+
+        coord_t* out_x = x + 1 + first_byte * STEPS_PER_BYTE;
+        coord_t* out_y = y + 1 + first_byte * STEPS_PER_BYTE;
+        for (size_t byte = 0; byte < bytes_count; byte++) {
+            coord_t point_x = bases_x[byte];
+            coord_t point_y = bases_y[byte];
+            for (int step = 0; step < STEPS_PER_BYTE; step++) {
+                const coord_t code = (codes[byte] >> (2 * step)) & 3;
+                point_x += step_code_dx(code);
+                point_y += step_code_dy(code);
+                out_x[byte * STEPS_PER_BYTE + step] = point_x;
+                out_y[byte * STEPS_PER_BYTE + step] = point_y;
+            }
+        }
+    }
+    for (size_t i = full_bytes * STEPS_PER_BYTE; i < steps_count; i++) {
+        const coord_t code = (payload[i / STEPS_PER_BYTE] >> (2 * (i % STEPS_PER_BYTE))) & 3;
+        current_x += step_code_dx(code);
+        current_y += step_code_dy(code);
+        x[i + 1] = current_x;
+        y[i + 1] = current_y;
+    }
+}
+
+/*
+ * Method converts the moore indexes to the points by batches
+ *
+ * The levels of the Hilbert's curve are the outer loop and the indexes of the batch are the inner loop.
+ * The quarter of every level is chosen by masks instead of branches, so the inner loop is vectorized.
+ * keys and x can be the same array.
+ */
+void keys_to_points(unsigned degree, const uint32_t* keys, coord_t* x, coord_t* y, size_t count) {
+    uint32_t digits[KEYS_BATCH_SIZE];
+    coord_t hilbert_x[KEYS_BATCH_SIZE];
+    coord_t hilbert_y[KEYS_BATCH_SIZE];
+    const coord_t k = (coord_t) 1 << (degree - 1);
+    for (size_t first = 0; first < count; first += KEYS_BATCH_SIZE) {
+        const size_t batch_size = count - first < KEYS_BATCH_SIZE ? count - first : KEYS_BATCH_SIZE;
+        for (size_t i = 0; i < batch_size; i++) {
+            digits[i] = keys[first + i];
+            hilbert_x[i] = 0;
+            hilbert_y[i] = 0;
+        }
+        // From the lowest level: the point inside the quarter is flipped and transposed by the orientation of the quarter
+        for (coord_t side = 1; side < k; side <<= 1) {
+            for (size_t i = 0; i < batch_size; i++) {
+                const coord_t rx = (digits[i] >> 1) & 1;
+                const coord_t ry = (digits[i] ^ rx) & 1;
+                const coord_t flip = (coord_t) -(rx & (ry ^ 1)) & (side - 1);
+                const coord_t flipped_x = hilbert_x[i] ^ flip;
+                const coord_t flipped_y = hilbert_y[i] ^ flip;
+                hilbert_x[i] = (ry ? flipped_x : flipped_y) + ((coord_t) -rx & side);
+                hilbert_y[i] = (ry ? flipped_y : flipped_x) + ((coord_t) -ry & side);
+                digits[i] >>= 2;
+            }
+        }
+        // The highest digit is the quarter of the moore curve, see transform_to_moore
+        for (size_t i = 0; i < batch_size; i++) {
+            const uint32_t quadrant = digits[i] & 3;
+            x[first + i] = quadrant < 2 ? k - 1 - hilbert_y[i] : hilbert_y[i] + k;
+            y[first + i] = (quadrant == 1 || quadrant == 2 ? k : 0) + (quadrant < 2 ? hilbert_x[i] : k - 1 - hilbert_x[i]);
+        }
+    }
+}
+
+/*
+ * Method decodes the group varint gaps to the moore indexes and the indexes to the points
+ *
+ * Every value is read as 4 bytes and masked by its length from the table, so there are no branches per byte.
+ * Parsing of the gaps is sequential, the indexes are stored to x and converted to the points by keys_to_points.
+ */
+bool decode_keys(const struct CodecHeader* header, const uint8_t* payload, coord_t* x, coord_t* y) {
+    struct GroupEntry table[256];
+    init_group_table(table);
+
+    const size_t points_number = header->points_number;
+    const size_t groups_count = (points_number + GROUP_SIZE - 1) / GROUP_SIZE;
+    size_t position = 0;
+    uint32_t key = 0;
+    for (size_t group = 0; group < groups_count; group++) {
+        if (position >= header->payload_size) {
+            return false;
+        }
+        const struct GroupEntry* entry = &table[payload[position++]];
+        if (position + entry->size > header->payload_size) {
+            return false;
+        }
+        const size_t first = group * GROUP_SIZE;
+        const int values_count = points_number - first < GROUP_SIZE ? (int) (points_number - first) : GROUP_SIZE;
+        for (int value = 0; value < GROUP_SIZE; value++) {
+            uint32_t gap;
+            memcpy(&gap, payload + position, sizeof(uint32_t));
+            key += gap & length_masks[entry->lengths[value]];
+            if (value < values_count) {
+                x[first + value] = key;
+            }
+            position += entry->lengths[value];
+        }
+    }
+    keys_to_points(header->degree, x, x, y, points_number);
+    return true;
+}
+
+void free_decoded_points(struct DecodedPoints* points) {
+    free_coords(points->x, points->count);
+    free_coords(points->y, points->count);
+    points->x = NULL;
+    points->y = NULL;
+}
+
+/*
+ * Method reads the compressed file of any mode. Returns false if the file is not valid
+ */
+bool decode_moore_points(const char* file_name, struct DecodedPoints* points) {
+    FILE* fptr = fopen(file_name, "rb");
+    if (fptr == NULL) {
+        return false;
+    }
+
+    struct CodecHeader header;
+    if (fread(&header, sizeof(struct CodecHeader), 1, fptr) != 1 || memcmp(header.magic, CODEC_MAGIC, CODEC_MAGIC_SIZE) != 0
+            || header.version != CODEC_VERSION || header.degree < 1 || header.degree > 15 || header.points_number == 0
+            || header.points_number > ((uint64_t) 1 << 30) || header.payload_size > ((uint64_t) 1 << 34)) {
+        fclose(fptr);
+        return false;
+    }
+    const bool has_valid_size = header.mode == CODEC_MODE_STEPS
+            ? header.payload_size == (header.points_number - 1 + STEPS_PER_BYTE - 1) / STEPS_PER_BYTE
+            : header.mode == CODEC_MODE_KEYS;
+    if (!has_valid_size) {
+        fclose(fptr);
+        return false;
+    }
+
+    uint8_t* payload = (uint8_t*) calloc(header.payload_size + PAYLOAD_PADDING, 1);
+    points->degree = header.degree;
+    points->count = header.points_number;
+    points->x = allocate_coords(points->count);
+    points->y = allocate_coords(points->count);
+    bool is_decoded = payload != NULL && points->x != NULL && points->y != NULL
+            && fread(payload, 1, header.payload_size, fptr) == header.payload_size;
+    fclose(fptr);
+
+    if (is_decoded) {
+        if (header.mode == CODEC_MODE_STEPS) {
+            decode_steps(&header, payload, points->x, points->y);
+        } else {
+            is_decoded = decode_keys(&header, payload, points->x, points->y);
+        }
+    }
+    free(payload);
+    if (!is_decoded) {
+        free_decoded_points(points);
+    }
+    return is_decoded;
+}
+
+double codec_seconds_since(const struct timespec* start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return end.tv_sec - start->tv_sec + 1e-9 * (end.tv_nsec - start->tv_nsec);
+}
+
+long file_size(const char* file_name) {
+    FILE* fptr = fopen(file_name, "rb");
+    if (fptr == NULL) {
+        return -1;
+    }
+    fseek(fptr, 0, SEEK_END);
+    long size = ftell(fptr);
+    fclose(fptr);
+    return size;
+}
+
+void print_compression(const char* file_name, size_t points_number) {
+    const long size = file_size(file_name);
+    printf("Points: %zu, compressed size: %ld bytes, %.3f bits per point\n",
+           points_number, size, 8.0 * size / points_number);
+}
+
+/*
+ * Method calculates the curve by the given solution and stores it as the step stream
+ */
+int encode_moore_curve(unsigned degree, int solution_type, const char* file_name) {
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    coord_t* x = allocate_coords(points_number);
+    coord_t* y = allocate_coords(points_number);
+    if (x == NULL || y == NULL) {
+        free_coords(x, points_number);
+        free_coords(y, points_number);
+        return CODEC_FILE_FAILED;
+    }
+
+    calc_moore_curve_points(degree, x, y, solution_type, false);
+    bool is_encoded = !malloc_is_failed() && encode_moore_steps(file_name, degree, x, y, points_number);
+    free_coords(x, points_number);
+    free_coords(y, points_number);
+    if (is_encoded) {
+        print_compression(file_name, points_number);
+    }
+    return is_encoded ? 0 : CODEC_FILE_FAILED;
+}
+
+/*
+ * Method reads the points "x, y" from the text file and stores them sorted by their moore indexes
+ *
+ * Returns TEXT_FILE_FAILED if the points can not be read or are out of the curve, CODEC_FILE_FAILED otherwise.
+ */
+int encode_points_file(unsigned degree, const char* text_file, const char* file_name) {
+    FILE* fptr = fopen(text_file, "r");
+    if (fptr == NULL) {
+        return TEXT_FILE_FAILED;
+    }
+
+    const coord_t side = (coord_t) 1 << degree;
+    size_t capacity = 1024;
+    size_t count = 0;
+    coord_t* x = (coord_t*) malloc(sizeof(coord_t) * capacity);
+    coord_t* y = (coord_t*) malloc(sizeof(coord_t) * capacity);
+    bool is_allocated = x != NULL && y != NULL;
+    bool is_read = is_allocated;
+    unsigned point_x;
+    unsigned point_y;
+    while (is_read && fscanf(fptr, "%u, %u", &point_x, &point_y) == 2) {
+        if (point_x >= side || point_y >= side) {
+            fprintf(stderr, "Point %u, %u is out of the curve of degree %u\n", point_x, point_y, degree);
+            is_read = false;
+            break;
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            coord_t* new_x = (coord_t*) realloc(x, sizeof(coord_t) * capacity);
+            coord_t* new_y = new_x == NULL ? NULL : (coord_t*) realloc(y, sizeof(coord_t) * capacity);
+            if (new_x != NULL) {
+                x = new_x;
+            }
+            if (new_y == NULL) {
+                is_allocated = false;
+                is_read = false;
+                break;
+            }
+            y = new_y;
+        }
+        x[count] = point_x;
+        y[count] = point_y;
+        count++;
+    }
+    is_read = is_read && feof(fptr) && count > 0;
+    fclose(fptr);
+
+    bool is_encoded = is_read && encode_moore_keys(file_name, degree, x, y, count);
+    free(x);
+    free(y);
+    if (is_encoded) {
+        print_compression(file_name, count);
+    }
+    // Allocation failures are reported as the failure of the compressed file, invalid points as the text file
+    return is_encoded ? 0 : is_allocated && !is_read ? TEXT_FILE_FAILED : CODEC_FILE_FAILED;
+}
+
+/*
+ * Method decodes the compressed file and prints the points to the text file
+ *
+ * Returns CODEC_FILE_FAILED if the compressed file is not valid, TEXT_FILE_FAILED if the points can not be written.
+ */
+int decode_to_text(const char* file_name, const char* output_file, bool with_benchmarking) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    struct DecodedPoints points;
+    if (!decode_moore_points(file_name, &points)) {
+        return CODEC_FILE_FAILED;
+    }
+    if (with_benchmarking) {
+        const double time = codec_seconds_since(&start);
+        printf("Time: %f (%.1f MB/s of coordinates)\n", time, 2 * sizeof(coord_t) * points.count / time / 1e6);
+    }
+
+    FILE* fptr = fopen(output_file, "w");
+    if (fptr == NULL) {
+        free_decoded_points(&points);
+        return TEXT_FILE_FAILED;
+    }
+    print_moore_curve_points(fptr, (int32_t) points.count, points.x, points.y);
+    fclose(fptr);
+    free_decoded_points(&points);
+    return 0;
+}
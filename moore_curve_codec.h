@@ -0,0 +1,16 @@
+#ifndef MOORE_CURVE_CODEC_H
+#define MOORE_CURVE_CODEC_H
+
+#include <stdbool.h>
+
+// Results of the codec functions: the compressed file or the text file of the points failed
+#define CODEC_FILE_FAILED -1
+#define TEXT_FILE_FAILED -2
+
+int encode_moore_curve(unsigned degree, int solution_type, const char* file_name);
+
+int encode_points_file(unsigned degree, const char* text_file, const char* file_name);
+
+int decode_to_text(const char* file_name, const char* output_file, bool with_benchmarking);
+
+#endif // MOORE_CURVE_CODEC_H
@@ -283,10 +283,12 @@ void process_commands(unsigned degree, const int32_t n, const char* commands, co
     }
 }
 
-static bool malloc_failed = false;
+static _Thread_local bool malloc_failed = false;
 
 /*
  * Used in rahmenprogramm.c to print error if allocation in this file fails
+ *
+ * The flag is thread local, so the solution can be called by several threads at once.
  */
 bool malloc_is_failed() {
     return malloc_failed;
@@ -164,4 +164,60 @@ void moore_gray_code(unsigned degree, coord_t* x, coord_t* y) {
         *(y + arr_size) = cur_y;
         arr_size += 1;
     }
-}
\ No newline at end of file
+}
+
+/*
+ * transforming coordinates in the moore curve of degree n to obtain coordinates in the Hilbert's curve of degree (n - 1)
+ * the inverse of transform_to_moore; returns one of the 4 quarters of space the point belongs to
+ */
+int transform_from_moore(coord_t* x_ptr, coord_t* y_ptr, int moore_n) {
+    coord_t cur_x = (*x_ptr);
+    coord_t cur_y = (*y_ptr);
+    coord_t k = (1 << (moore_n - 1));
+    int quadrant;
+
+    if (cur_x < k) {
+        quadrant = cur_y < k ? 0 : 1;
+        (*x_ptr) = cur_y < k ? cur_y : cur_y - k;
+        (*y_ptr) = (k - 1) - cur_x;
+    } else {
+        quadrant = cur_y < k ? 3 : 2;
+        (*x_ptr) = cur_y < k ? (k - 1) - cur_y : (k - 1) - (cur_y - k);
+        (*y_ptr) = cur_x - k;
+    }
+    return quadrant;
+}
+
+/*
+ * obtaining the index of the vertex in the Hilbert's curve of degree n from its coordinates;
+ * at every level the quarter of the point is found and the coordinates are rotated into the quarter's orientation
+ */
+size_t hilbert_index(coord_t xs, coord_t ys, int n) {
+    size_t index = 0;
+    for (coord_t s = (coord_t) 1 << n >> 1; s > 0; s >>= 1) {
+        coord_t rx = (xs & s) > 0;
+        coord_t ry = (ys & s) > 0;
+        index += (size_t) s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                xs = (s - 1) - (xs & (s - 1));
+                ys = (s - 1) - (ys & (s - 1));
+            }
+            coord_t temp = xs;
+            xs = ys;
+            ys = temp;
+        }
+        xs &= s - 1;
+        ys &= s - 1;
+    }
+    return index;
+}
+
+/*
+ * obtaining the index of the vertex in the moore curve of degree moore_n from its coordinates;
+ * the inverse of get_coordinates
+ */
+size_t get_index(coord_t x, coord_t y, int moore_n) {
+    int quadrant = transform_from_moore(&x, &y, moore_n);
+    return ((size_t) quadrant << (2 * (moore_n - 1))) | hilbert_index(x, y, moore_n - 1);
+}
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#define DEFAULT_CACHE_MEMORY_BUDGET ((size_t) 256 << 20)
+
+typedef uint32_t coord_t;
+
+/*
+ * Process-wide cache of the Hilbert's curve of the biggest calculated degree
+ *
+ * The moore curve of degree n consists of 4 transformed copies of the Hilbert's curve of degree (n - 1)
+ * (see transform_to_moore in moore_curve_gray_code.c), and the Hilbert's curve of degree n consists of 4 transformed copies
+ * of the Hilbert's curve of degree (n - 1). So the curve of the next degree is derived from the cached one.
+ *
+ * The first quarter of the Hilbert's curve of degree n is the transposed curve of degree (n - 1),
+ * so all lower degrees are prefixes of the cached curve.
+ */
+struct HilbertCache {
+    int degree; // -1 if the cache is empty
+    coord_t* x;
+    coord_t* y;
+};
+
+static struct HilbertCache hilbert_cache = {-1, NULL, NULL};
+static size_t cache_memory_budget = DEFAULT_CACHE_MEMORY_BUDGET;
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+size_t hilbert_points_count(int degree) {
+    return (size_t) 1 << (2 * degree);
+}
+
+size_t hilbert_memory_size(int degree) {
+    return 2 * sizeof(coord_t) * hilbert_points_count(degree);
+}
+
+/*
+ * Method extends the Hilbert's curve of degree from_degree stored in x and y to the degree to_degree
+ *
+ * x and y must have space for all points of the curve of degree to_degree.
+ * Quarters 1, 2 and 3 are written from the untouched first quarter, then the first quarter is transposed in place.
+ */
+void extend_hilbert(coord_t* x, coord_t* y, int from_degree, int to_degree) {
+    for (int degree = from_degree; degree < to_degree; degree++) {
+        const size_t n = hilbert_points_count(degree);
+        const coord_t k = (coord_t) 1 << degree;
+
+        for (size_t i = 0; i < n; i++) {
+            const coord_t cur_x = x[i];
+            const coord_t cur_y = y[i];
+            x[n + i] = cur_x;
+            y[n + i] = cur_y + k;
+            x[2 * n + i] = cur_x + k;
+            y[2 * n + i] = cur_y + k;
+            x[3 * n + i] = (2 * k - 1) - cur_y;
+            y[3 * n + i] = (k - 1) - cur_x;
+        }
+        for (size_t i = 0; i < n; i++) {
+            const coord_t cur_x = x[i];
+            x[i] = y[i];
+            y[i] = cur_x;
+        }
+    }
+}
+
+/*
+ * Method transforms the Hilbert's curve of degree (moore_degree - 1) stored in the first quarter of x and y
+ * to the moore curve of degree moore_degree
+ */
+void hilbert_to_moore(coord_t* x, coord_t* y, unsigned moore_degree) {
+    const size_t n = hilbert_points_count(moore_degree - 1);
+    const coord_t k = (coord_t) 1 << (moore_degree - 1);
+
+    for (size_t i = 0; i < n; i++) {
+        const coord_t cur_x = x[i];
+        const coord_t cur_y = y[i];
+        x[n + i] = (k - 1) - cur_y;
+        y[n + i] = cur_x + k;
+        x[2 * n + i] = cur_y + k;
+        y[2 * n + i] = (k - 1) - cur_x + k;
+        x[3 * n + i] = cur_y + k;
+        y[3 * n + i] = (k - 1) - cur_x;
+    }
+    for (size_t i = 0; i < n; i++) {
+        const coord_t cur_x = x[i];
+        x[i] = (k - 1) - y[i];
+        y[i] = cur_x;
+    }
+}
+
+/*
+ * Method copies the Hilbert's curve of the given degree from the cache (cached degree must be not less than the given)
+ */
+void copy_hilbert_from_cache(coord_t* x, coord_t* y, int degree) {
+    const size_t n = hilbert_points_count(degree);
+    if ((hilbert_cache.degree - degree) % 2 == 0) {
+        memcpy(x, hilbert_cache.x, sizeof(coord_t) * n);
+        memcpy(y, hilbert_cache.y, sizeof(coord_t) * n);
+    } else {
+        memcpy(x, hilbert_cache.y, sizeof(coord_t) * n);
+        memcpy(y, hilbert_cache.x, sizeof(coord_t) * n);
+    }
+}
+
+void clear_cache_locked() {
+    free(hilbert_cache.x);
+    free(hilbert_cache.y);
+    hilbert_cache.degree = -1;
+    hilbert_cache.x = NULL;
+    hilbert_cache.y = NULL;
+}
+
+/*
+ * Method tries to extend the cached curve to the given degree
+ *
+ * If the curve of the given degree does not fit into the memory budget, the cache keeps the previous curve.
+ */
+bool grow_cache_locked(int degree) {
+    if (hilbert_memory_size(degree) > cache_memory_budget) {
+        return false;
+    }
+
+    const size_t n = hilbert_points_count(degree);
+    coord_t* new_x = (coord_t*) realloc(hilbert_cache.x, sizeof(coord_t) * n);
+    if (new_x == NULL) {
+        return false;
+    }
+    hilbert_cache.x = new_x;
+
+    coord_t* new_y = (coord_t*) realloc(hilbert_cache.y, sizeof(coord_t) * n);
+    if (new_y == NULL) {
+        return false;
+    }
+    hilbert_cache.y = new_y;
+
+    if (hilbert_cache.degree < 0) {
+        hilbert_cache.x[0] = 0;
+        hilbert_cache.y[0] = 0;
+        hilbert_cache.degree = 0;
+    }
+    extend_hilbert(hilbert_cache.x, hilbert_cache.y, hilbert_cache.degree, degree);
+    hilbert_cache.degree = degree;
+    return true;
+}
+
+/*
+ * Sets the maximum memory in bytes used by the cache. The cached curve is evicted if it does not fit
+ */
+void moore_incremental_set_cache_budget(size_t bytes) {
+    pthread_mutex_lock(&cache_mutex);
+    cache_memory_budget = bytes;
+    if (hilbert_cache.degree >= 0 && hilbert_memory_size(hilbert_cache.degree) > cache_memory_budget) {
+        clear_cache_locked();
+    }
+    pthread_mutex_unlock(&cache_mutex);
+}
+
+/*
+ * Frees the memory of the cache
+ */
+void moore_incremental_clear_cache() {
+    pthread_mutex_lock(&cache_mutex);
+    clear_cache_locked();
+    pthread_mutex_unlock(&cache_mutex);
+}
+
+/*
+ * Method finds points coordinates of the moore curve using the cached curve of the previous degrees.
+ *
+ * When degree <= 0 function will print an error.
+ */
+void moore_incremental(unsigned degree, coord_t* x, coord_t* y) {
+    if (degree <= 0 || degree > 15) {
+        fprintf(stderr, "Moore curve degree must be between 1 and 15");
+        return;
+    }
+
+    const int hilbert_degree = (int) degree - 1;
+
+    pthread_mutex_lock(&cache_mutex);
+    int copied_degree = 0;
+    if (hilbert_cache.degree >= hilbert_degree || grow_cache_locked(hilbert_degree)) {
+        copy_hilbert_from_cache(x, y, hilbert_degree);
+        copied_degree = hilbert_degree;
+    } else if (hilbert_cache.degree >= 0) {
+        copy_hilbert_from_cache(x, y, hilbert_cache.degree);
+        copied_degree = hilbert_cache.degree;
+    } else {
+        x[0] = 0;
+        y[0] = 0;
+    }
+    pthread_mutex_unlock(&cache_mutex);
+
+    // The curve is too big for the cache, so it is extended in the result arrays
+    extend_hilbert(x, y, copied_degree, hilbert_degree);
+    hilbert_to_moore(x, y, degree);
+}
@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define JOB_LINE_SIZE 4096
+#define JOB_PATH_SIZE 4096
+
+// Output formats of the jobs
+#define FORMAT_TXT 0
+#define FORMAT_SVG 1
+
+typedef uint32_t coord_t;
+
+/*
+ * One line of the jobs file: degree, solution, format and output path
+ */
+struct Job {
+    unsigned degree;
+    int solution_type;
+    int format;
+    char output_file[JOB_PATH_SIZE];
+    double time;
+    bool failed;
+};
+
+/*
+ * Deque of the job indexes of one worker
+ *
+ * The owner takes jobs from the bottom, other workers steal from the top.
+ */
+struct JobDeque {
+    size_t* jobs;
+    size_t top;
+    size_t bottom;
+    pthread_mutex_t mutex;
+};
+
+/*
+ * Buffers reused by all jobs of one worker. They grow up to the biggest job of the worker
+ */
+struct JobArena {
+    coord_t* x;
+    coord_t* y;
+    size_t capacity;
+};
+
+struct JobsPool {
+    struct Job* jobs;
+    struct JobDeque* deques;
+    size_t workers_count;
+};
+
+struct JobsWorker {
+    struct JobsPool* pool;
+    size_t index;
+    size_t completed_jobs;
+    size_t stolen_jobs;
+};
+
+double calc_moore_curve_points(unsigned degree, coord_t* x, coord_t* y, int solution_type, bool with_benchmarking);
+
+bool malloc_is_failed();
+
+void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y);
+
+void print_to_svg(FILE *fptr, unsigned degree, const int32_t points_number, coord_t* x, coord_t* y);
+
+
+size_t job_points_number(const struct Job* job) {
+    return (size_t) 1 << (2 * job->degree);
+}
+
+/*
+ * Method parses the line of the jobs file. Empty lines and lines starting with # are skipped
+ *
+ * Returns 1 if the job is parsed, 0 if the line is skipped and -1 if the line is invalid.
+ */
+int parse_job(const char* line, int solutions_count, struct Job* job) {
+    char format[16];
+    const char* start = line + strspn(line, " \t\r\n");
+    if (*start == '\0' || *start == '#') {
+        return 0;
+    }
+
+    int degree;
+    if (sscanf(start, "%d %d %15s %4095s", &degree, &job->solution_type, format, job->output_file) != 4) {
+        return -1;
+    }
+    if (degree < 1 || degree > 15 || job->solution_type < 0 || job->solution_type >= solutions_count) {
+        return -1;
+    }
+
+    if (strcmp(format, "txt") == 0) {
+        job->format = FORMAT_TXT;
+    } else if (strcmp(format, "svg") == 0) {
+        job->format = FORMAT_SVG;
+    } else {
+        return -1;
+    }
+    job->degree = degree;
+    job->time = 0.0;
+    job->failed = false;
+    return 1;
+}
+
+/*
+ * Method reads all jobs from the file. Returns the number of jobs or -1 if the file is invalid
+ */
+long read_jobs(const char* jobs_file, int solutions_count, struct Job** jobs) {
+    FILE* fptr = fopen(jobs_file, "r");
+    if (fptr == NULL) {
+        return -1;
+    }
+
+    char line[JOB_LINE_SIZE];
+    size_t capacity = 0;
+    long jobs_count = 0;
+    *jobs = NULL;
+    while (fgets(line, JOB_LINE_SIZE, fptr) != NULL) {
+        if (jobs_count == (long) capacity) {
+            capacity = capacity == 0 ? 16 : 2 * capacity;
+            struct Job* new_jobs = (struct Job*) realloc(*jobs, sizeof(struct Job) * capacity);
+            if (new_jobs == NULL) {
+                jobs_count = -1;
+                break;
+            }
+            *jobs = new_jobs;
+        }
+
+        int parsed = parse_job(line, solutions_count, &(*jobs)[jobs_count]);
+        if (parsed < 0) {
+            fprintf(stderr, "Invalid job: %s", line);
+            jobs_count = -1;
+            break;
+        }
+        jobs_count += parsed;
+    }
+    fclose(fptr);
+
+    if (jobs_count < 0) {
+        free(*jobs);
+        *jobs = NULL;
+    }
+    return jobs_count;
+}
+
+/*
+ * Takes the job from the bottom of own deque or steals it from the top of other deques
+ */
+bool take_job(struct JobsWorker* worker, size_t* job_index) {
+    struct JobsPool* pool = worker->pool;
+    for (size_t i = 0; i < pool->workers_count; i++) {
+        const size_t victim = (worker->index + i) % pool->workers_count;
+        struct JobDeque* deque = &pool->deques[victim];
+
+        pthread_mutex_lock(&deque->mutex);
+        bool is_taken = deque->top < deque->bottom;
+        if (is_taken) {
+            *job_index = victim == worker->index ? deque->jobs[--deque->bottom] : deque->jobs[deque->top++];
+        }
+        pthread_mutex_unlock(&deque->mutex);
+
+        if (is_taken) {
+            worker->stolen_jobs += victim != worker->index;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool reserve_arena(struct JobArena* arena, size_t points_number) {
+    if (arena->capacity >= points_number) {
+        return true;
+    }
+    free(arena->x);
+    free(arena->y);
+    arena->x = (coord_t*) malloc(sizeof(coord_t) * points_number);
+    arena->y = (coord_t*) malloc(sizeof(coord_t) * points_number);
+    arena->capacity = arena->x != NULL && arena->y != NULL ? points_number : 0;
+    return arena->capacity > 0;
+}
+
+void run_job(struct Job* job, struct JobArena* arena) {
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    const size_t points_number = job_points_number(job);
+    FILE* fptr = NULL;
+    job->failed = !reserve_arena(arena, points_number) || (fptr = fopen(job->output_file, "w")) == NULL;
+    if (!job->failed) {
+        calc_moore_curve_points(job->degree, arena->x, arena->y, job->solution_type, false);
+        job->failed = malloc_is_failed();
+    }
+    if (!job->failed) {
+        if (job->format == FORMAT_TXT) {
+            print_moore_curve_points(fptr, (int32_t) points_number, arena->x, arena->y);
+        } else {
+            print_to_svg(fptr, job->degree, (int32_t) points_number, arena->x, arena->y);
+        }
+    }
+    if (fptr != NULL) {
+        job->failed |= fclose(fptr) != 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    job->time = end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+}
+
+void* jobs_worker(void* argument) {
+    struct JobsWorker* worker = (struct JobsWorker*) argument;
+    struct JobArena arena = {NULL, NULL, 0};
+    size_t job_index;
+    while (take_job(worker, &job_index)) {
+        run_job(&worker->pool->jobs[job_index], &arena);
+        worker->completed_jobs++;
+    }
+    free(arena.x);
+    free(arena.y);
+    return NULL;
+}
+
+int compare_jobs_by_size(const void* lhs, const void* rhs) {
+    const struct Job* lhs_job = (const struct Job*) lhs;
+    const struct Job* rhs_job = (const struct Job*) rhs;
+    return (int) rhs_job->degree - (int) lhs_job->degree;
+}
+
+/*
+ * Method runs all jobs from the file on the work-stealing pool of threads and prints the throughput summary
+ *
+ * The biggest jobs are distributed first, so the total time is close to the time of the biggest job.
+ * Curves of the incremental solution (-V 3) are cached by all workers together.
+ */
+int run_jobs(const char* jobs_file, int solutions_count) {
+    struct Job* jobs;
+    long jobs_count = read_jobs(jobs_file, solutions_count, &jobs);
+    if (jobs_count <= 0) {
+        return -1;
+    }
+    qsort(jobs, jobs_count, sizeof(struct Job), compare_jobs_by_size);
+
+    long workers_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers_count < 1) {
+        workers_count = 1;
+    }
+    if (workers_count > jobs_count) {
+        workers_count = jobs_count;
+    }
+
+    struct JobsPool pool = {jobs, NULL, (size_t) workers_count};
+    pool.deques = (struct JobDeque*) calloc(workers_count, sizeof(struct JobDeque));
+    struct JobsWorker* workers = (struct JobsWorker*) calloc(workers_count, sizeof(struct JobsWorker));
+    pthread_t* threads = (pthread_t*) malloc(sizeof(pthread_t) * workers_count);
+    size_t* deque_jobs = (size_t*) malloc(sizeof(size_t) * jobs_count);
+    if (pool.deques == NULL || workers == NULL || threads == NULL || deque_jobs == NULL) {
+        free(pool.deques);
+        free(workers);
+        free(threads);
+        free(deque_jobs);
+        free(jobs);
+        return -1;
+    }
+
+    // Jobs are dealt round-robin, the owner takes the biggest of its jobs first, thieves take the smallest
+    size_t deque_start = 0;
+    for (long i = 0; i < workers_count; i++) {
+        struct JobDeque* deque = &pool.deques[i];
+        deque->jobs = deque_jobs + deque_start;
+        pthread_mutex_init(&deque->mutex, NULL);
+        for (long job = i; job < jobs_count; job += workers_count) {
+            deque->bottom++;
+        }
+        for (size_t j = 0; j < deque->bottom; j++) {
+            deque->jobs[deque->bottom - 1 - j] = i + j * workers_count;
+        }
+        deque_start += deque->bottom;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < workers_count; i++) {
+        workers[i] = (struct JobsWorker) {&pool, (size_t) i, 0, 0};
+        pthread_create(&threads[i], NULL, jobs_worker, &workers[i]);
+    }
+    size_t stolen_jobs = 0;
+    for (long i = 0; i < workers_count; i++) {
+        pthread_join(threads[i], NULL);
+        stolen_jobs += workers[i].stolen_jobs;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double time = end.tv_sec - start.tv_sec + 1e-9 * (end.tv_nsec - start.tv_nsec);
+
+    double jobs_time = 0.0;
+    double points_number = 0.0;
+    long failed_jobs = 0;
+    for (long i = 0; i < jobs_count; i++) {
+        if (jobs[i].failed) {
+            fprintf(stderr, "Job failed: %s\n", jobs[i].output_file);
+            failed_jobs++;
+            continue;
+        }
+        jobs_time += jobs[i].time;
+        points_number += job_points_number(&jobs[i]);
+    }
+
+    printf("Jobs: %ld (%ld failed, %zu stolen, %ld workers)\n", jobs_count, failed_jobs, stolen_jobs, workers_count);
+    printf("Time: %f\n", time);
+    printf("Summary jobs time: %f\n", jobs_time);
+    printf("Points per second: %.0f\n", points_number / time);
+
+    for (long i = 0; i < workers_count; i++) {
+        pthread_mutex_destroy(&pool.deques[i].mutex);
+    }
+    free(pool.deques);
+    free(workers);
+    free(threads);
+    free(deque_jobs);
+    free(jobs);
+    return failed_jobs == 0 ? 0 : -1;
+}
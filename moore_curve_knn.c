@@ -0,0 +1,384 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "moore_curve_knn.h"
+
+#define MAX_KNN_DEGREE 14
+// Every SAMPLE_STEP-th key is copied to the samples, so the binary search touches only a few cache lines
+#define SAMPLE_STEP 64
+#define RADIX_BITS 11
+
+// Results of the timed queries are written here, so the compiler does not remove the queries
+static volatile uint64_t queries_sink;
+
+size_t get_index(coord_t x, coord_t y, int moore_n);
+
+
+static inline uint64_t squared_distance(coord_t x1, coord_t y1, coord_t x2, coord_t y2) {
+    const int64_t dx = (int64_t) x1 - x2;
+    const int64_t dy = (int64_t) y1 - y2;
+    return (uint64_t) (dx * dx + dy * dy);
+}
+
+/*
+ * Method sorts the keys with the ids by the least significant digit radix sort
+ */
+bool radix_sort_keys(uint32_t* keys, uint32_t* ids, size_t count, int key_bits) {
+    uint32_t* buffer_keys = (uint32_t*) malloc(sizeof(uint32_t) * count);
+    uint32_t* buffer_ids = (uint32_t*) malloc(sizeof(uint32_t) * count);
+    if (buffer_keys == NULL || buffer_ids == NULL) {
+        free(buffer_keys);
+        free(buffer_ids);
+        return false;
+    }
+
+    const int passes = (key_bits + RADIX_BITS - 1) / RADIX_BITS;
+    for (int pass = 0; pass < passes; pass++) {
+        const int shift = pass * RADIX_BITS;
+        size_t offsets[1 << RADIX_BITS];
+        memset(offsets, 0, sizeof(offsets));
+        for (size_t i = 0; i < count; i++) {
+            offsets[(keys[i] >> shift) & ((1 << RADIX_BITS) - 1)]++;
+        }
+        size_t sum = 0;
+        for (int digit = 0; digit < (1 << RADIX_BITS); digit++) {
+            const size_t digit_count = offsets[digit];
+            offsets[digit] = sum;
+            sum += digit_count;
+        }
+        for (size_t i = 0; i < count; i++) {
+            const size_t position = offsets[(keys[i] >> shift) & ((1 << RADIX_BITS) - 1)]++;
+            buffer_keys[position] = keys[i];
+            buffer_ids[position] = ids[i];
+        }
+        memcpy(keys, buffer_keys, sizeof(uint32_t) * count);
+        memcpy(ids, buffer_ids, sizeof(uint32_t) * count);
+    }
+
+    free(buffer_keys);
+    free(buffer_ids);
+    return true;
+}
+
+void free_curve_order(struct MooreCurveOrder* curve) {
+    free(curve->keys);
+    free(curve->ids);
+    free(curve->x);
+    free(curve->y);
+    free(curve->samples);
+}
+
+bool build_curve_order(unsigned degree, const coord_t* x, const coord_t* y, size_t count, struct MooreCurveOrder* curve) {
+    curve->samples_count = (count + SAMPLE_STEP - 1) / SAMPLE_STEP;
+    curve->keys = (uint32_t*) malloc(sizeof(uint32_t) * count);
+    curve->ids = (uint32_t*) malloc(sizeof(uint32_t) * count);
+    curve->x = (coord_t*) malloc(sizeof(coord_t) * count);
+    curve->y = (coord_t*) malloc(sizeof(coord_t) * count);
+    curve->samples = (uint32_t*) malloc(sizeof(uint32_t) * curve->samples_count);
+    if (curve->keys == NULL || curve->ids == NULL || curve->x == NULL || curve->y == NULL || curve->samples == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        curve->keys[i] = (uint32_t) get_index(x[i] + curve->shift, y[i] + curve->shift, degree + 1);
+        curve->ids[i] = (uint32_t) i;
+    }
+    if (!radix_sort_keys(curve->keys, curve->ids, count, 2 * (degree + 1))) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        curve->x[i] = x[curve->ids[i]];
+        curve->y[i] = y[curve->ids[i]];
+    }
+    for (size_t i = 0; i < curve->samples_count; i++) {
+        curve->samples[i] = curve->keys[i * SAMPLE_STEP];
+    }
+    return true;
+}
+
+void moore_knn_free(struct MooreKnnIndex* index) {
+    if (index == NULL) {
+        return;
+    }
+    for (int curve = 0; curve < index->curves_count; curve++) {
+        free_curve_order(&index->curves[curve]);
+    }
+    free(index);
+}
+
+/*
+ * Method builds the index of the points of the 2^degree x 2^degree grid
+ *
+ * Curve i is shifted by i * 2^degree / curves_count along both axes. Returns NULL if the memory can not be allocated.
+ */
+struct MooreKnnIndex* moore_knn_build(unsigned degree, const coord_t* x, const coord_t* y, size_t count, int curves_count) {
+    if (degree < 1 || degree > MAX_KNN_DEGREE || count == 0 || count > UINT32_MAX
+            || curves_count < 1 || curves_count > MOORE_KNN_MAX_CURVES) {
+        return NULL;
+    }
+
+    struct MooreKnnIndex* index = (struct MooreKnnIndex*) calloc(1, sizeof(struct MooreKnnIndex));
+    if (index == NULL) {
+        return NULL;
+    }
+    index->degree = degree;
+    index->count = count;
+    index->curves_count = curves_count;
+    for (int curve = 0; curve < curves_count; curve++) {
+        index->curves[curve].shift = (coord_t) (((size_t) curve << degree) / curves_count);
+        if (!build_curve_order(degree, x, y, count, &index->curves[curve])) {
+            moore_knn_free(index);
+            return NULL;
+        }
+    }
+    return index;
+}
+
+/*
+ * Method returns the position of the first key that is not less than the given key
+ *
+ * The binary search runs over the samples, then at most SAMPLE_STEP keys are scanned.
+ */
+size_t seek_key(const struct MooreCurveOrder* curve, size_t count, uint32_t key) {
+    size_t low = 0;
+    size_t high = curve->samples_count;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (curve->samples[middle] < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    size_t position = low == 0 ? 0 : (low - 1) * SAMPLE_STEP;
+    while (position < count && curve->keys[position] < key) {
+        position++;
+    }
+    return position;
+}
+
+/*
+ * Method inserts the neighbour to the sorted array of the k nearest neighbours. Ids that are already found are skipped
+ */
+void insert_neighbour(struct Neighbour* neighbours, size_t* found, size_t k, uint64_t distance, uint32_t id) {
+    if (*found == k && distance >= neighbours[k - 1].distance) {
+        return;
+    }
+    for (size_t i = 0; i < *found; i++) {
+        if (neighbours[i].id == id) {
+            return;
+        }
+    }
+
+    size_t position = *found < k ? (*found)++ : k - 1;
+    while (position > 0 && neighbours[position - 1].distance > distance) {
+        neighbours[position] = neighbours[position - 1];
+        position--;
+    }
+    neighbours[position].distance = distance;
+    neighbours[position].id = id;
+}
+
+/*
+ * Method finds approximately k nearest neighbours of the point
+ *
+ * On every curve only window points before and window points after the position of the query are checked.
+ * Neighbours are sorted by distance. Returns the number of found neighbours.
+ */
+size_t moore_knn_query(const struct MooreKnnIndex* index, coord_t x, coord_t y, size_t k, size_t window,
+                       struct Neighbour* neighbours) {
+    size_t found = 0;
+    if (k == 0) {
+        return 0;
+    }
+    for (int c = 0; c < index->curves_count; c++) {
+        const struct MooreCurveOrder* curve = &index->curves[c];
+        const uint32_t key = (uint32_t) get_index(x + curve->shift, y + curve->shift, index->degree + 1);
+        const size_t position = seek_key(curve, index->count, key);
+        const size_t first = position < window ? 0 : position - window;
+        const size_t last = position + window > index->count ? index->count : position + window;
+        for (size_t i = first; i < last; i++) {
+            insert_neighbour(neighbours, &found, k, squared_distance(x, y, curve->x[i], curve->y[i]), curve->ids[i]);
+        }
+    }
+    return found;
+}
+
+int compare_ids(const void* first, const void* second) {
+    const uint32_t a = *(const uint32_t*) first;
+    const uint32_t b = *(const uint32_t*) second;
+    return (a > b) - (a < b);
+}
+
+/*
+ * Method finds approximately the points in the circle with the given center and radius
+ *
+ * The same windows as in moore_knn_query are checked. Returns the number of found points,
+ * at most max_count ids are written.
+ */
+size_t moore_radius_query(const struct MooreKnnIndex* index, coord_t x, coord_t y, double radius, size_t window,
+                          uint32_t* ids, size_t max_count) {
+    const uint64_t squared_radius = (uint64_t) (radius * radius);
+    size_t found = 0;
+    for (int c = 0; c < index->curves_count; c++) {
+        const struct MooreCurveOrder* curve = &index->curves[c];
+        const uint32_t key = (uint32_t) get_index(x + curve->shift, y + curve->shift, index->degree + 1);
+        const size_t position = seek_key(curve, index->count, key);
+        const size_t first = position < window ? 0 : position - window;
+        const size_t last = position + window > index->count ? index->count : position + window;
+        for (size_t i = first; i < last && found < max_count; i++) {
+            if (squared_distance(x, y, curve->x[i], curve->y[i]) <= squared_radius) {
+                ids[found++] = curve->ids[i];
+            }
+        }
+    }
+
+    // Different curves can find the same points
+    if (index->curves_count > 1 && found > 1) {
+        qsort(ids, found, sizeof(uint32_t), compare_ids);
+        size_t unique = 1;
+        for (size_t i = 1; i < found; i++) {
+            if (ids[i] != ids[unique - 1]) {
+                ids[unique++] = ids[i];
+            }
+        }
+        found = unique;
+    }
+    return found;
+}
+
+double knn_now() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+/*
+ * Method compares the index with the brute force search on random points and random queries
+ *
+ * The radius of the radius queries is chosen so that k points are expected in the circle.
+ * Recall of kNN is the share of the found neighbours that are not farther than the exact k-th neighbour.
+ */
+int run_knn_benchmark(unsigned degree, size_t points_count, int queries_count, int k, int window, int curves_count) {
+    const coord_t side = (coord_t) 1 << degree;
+    const double radius = side * sqrt(k / (M_PI * points_count));
+    coord_t* x = (coord_t*) malloc(sizeof(coord_t) * points_count);
+    coord_t* y = (coord_t*) malloc(sizeof(coord_t) * points_count);
+    coord_t* query_x = (coord_t*) malloc(sizeof(coord_t) * queries_count);
+    coord_t* query_y = (coord_t*) malloc(sizeof(coord_t) * queries_count);
+    struct Neighbour* neighbours = (struct Neighbour*) malloc(sizeof(struct Neighbour) * k);
+    struct Neighbour* exact_neighbours = (struct Neighbour*) malloc(sizeof(struct Neighbour) * k);
+    uint32_t* ids = (uint32_t*) malloc(sizeof(uint32_t) * points_count);
+    if (x == NULL || y == NULL || query_x == NULL || query_y == NULL || neighbours == NULL || exact_neighbours == NULL
+            || ids == NULL) {
+        fprintf(stderr, "Failed memory allocation\n");
+        free(x);
+        free(y);
+        free(query_x);
+        free(query_y);
+        free(neighbours);
+        free(exact_neighbours);
+        free(ids);
+        return -1;
+    }
+
+    unsigned seed = 12345;
+    for (size_t i = 0; i < points_count; i++) {
+        x[i] = (coord_t) rand_r(&seed) & (side - 1);
+        y[i] = (coord_t) rand_r(&seed) & (side - 1);
+    }
+    for (int i = 0; i < queries_count; i++) {
+        query_x[i] = (coord_t) rand_r(&seed) & (side - 1);
+        query_y[i] = (coord_t) rand_r(&seed) & (side - 1);
+    }
+
+    double start = knn_now();
+    struct MooreKnnIndex* index = moore_knn_build(degree, x, y, points_count, curves_count);
+    const double build_time = knn_now() - start;
+    if (index == NULL) {
+        fprintf(stderr, "Failed to build the index\n");
+        free(x);
+        free(y);
+        free(query_x);
+        free(query_y);
+        free(neighbours);
+        free(exact_neighbours);
+        free(ids);
+        return -1;
+    }
+
+    // Results of the queries are checked after the timed loops, so the loops are run twice
+    uint64_t checksum = 0;
+    start = knn_now();
+    for (int q = 0; q < queries_count; q++) {
+        const size_t found = moore_knn_query(index, query_x[q], query_y[q], k, window, neighbours);
+        checksum += found > 0 ? neighbours[found - 1].distance : 0;
+    }
+    const double knn_time = knn_now() - start;
+
+    start = knn_now();
+    for (int q = 0; q < queries_count; q++) {
+        checksum += moore_radius_query(index, query_x[q], query_y[q], radius, window, ids, points_count);
+    }
+    const double radius_time = knn_now() - start;
+
+    start = knn_now();
+    for (int q = 0; q < queries_count; q++) {
+        size_t found = 0;
+        for (size_t i = 0; i < points_count; i++) {
+            insert_neighbour(exact_neighbours, &found, k, squared_distance(query_x[q], query_y[q], x[i], y[i]), (uint32_t) i);
+        }
+        checksum += exact_neighbours[found - 1].distance;
+    }
+    const double brute_force_time = knn_now() - start;
+
+    queries_sink = checksum;
+
+    const uint64_t squared_radius = (uint64_t) (radius * radius);
+    size_t knn_hits = 0;
+    size_t knn_expected = 0;
+    size_t radius_hits = 0;
+    size_t radius_expected = 0;
+    for (int q = 0; q < queries_count; q++) {
+        size_t exact_found = 0;
+        size_t exact_in_radius = 0;
+        for (size_t i = 0; i < points_count; i++) {
+            const uint64_t distance = squared_distance(query_x[q], query_y[q], x[i], y[i]);
+            insert_neighbour(exact_neighbours, &exact_found, k, distance, (uint32_t) i);
+            exact_in_radius += distance <= squared_radius;
+        }
+        const size_t found = moore_knn_query(index, query_x[q], query_y[q], k, window, neighbours);
+        for (size_t i = 0; i < found; i++) {
+            knn_hits += neighbours[i].distance <= exact_neighbours[exact_found - 1].distance;
+        }
+        knn_expected += exact_found;
+        radius_hits += moore_radius_query(index, query_x[q], query_y[q], radius, window, ids, points_count);
+        radius_expected += exact_in_radius;
+    }
+
+    printf("Points: %zu, queries: %d, k: %d, window: %d, curves: %d, radius: %f\n",
+           points_count, queries_count, k, window, curves_count, radius);
+    printf("Build time: %f\n", build_time);
+    printf("kNN: %f us per query, recall %.4f\n", 1e6 * knn_time / queries_count,
+           knn_expected == 0 ? 1.0 : (double) knn_hits / knn_expected);
+    printf("Radius: %f us per query, recall %.4f\n", 1e6 * radius_time / queries_count,
+           radius_expected == 0 ? 1.0 : (double) radius_hits / radius_expected);
+    printf("Brute force kNN: %f us per query, speedup %.1fx\n", 1e6 * brute_force_time / queries_count,
+           knn_time > 0 ? brute_force_time / knn_time : 0.0);
+
+    moore_knn_free(index);
+    free(x);
+    free(y);
+    free(query_x);
+    free(query_y);
+    free(neighbours);
+    free(exact_neighbours);
+    free(ids);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef MOORE_CURVE_KNN_H
+#define MOORE_CURVE_KNN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOORE_KNN_MAX_CURVES 8
+
+typedef uint32_t coord_t;
+
+/*
+ * Points sorted along one moore curve. The points are shifted before their keys are calculated
+ */
+struct MooreCurveOrder {
+    coord_t shift;
+    uint32_t* keys;
+    uint32_t* ids;
+    // Coordinates are stored in the order of the keys, so the scanned window is contiguous in memory
+    coord_t* x;
+    coord_t* y;
+    uint32_t* samples;
+    size_t samples_count;
+};
+
+/*
+ * Index of the points of the 2^degree x 2^degree grid
+ *
+ * Points are sorted by their indexes in the moore curve of degree (degree + 1), so the points shifted
+ * by up to 2^degree still fit into the curve. Several curves with different shifts can be used: the points
+ * that are close but lie on the different sides of a big square of one curve are close along another curve.
+ */
+struct MooreKnnIndex {
+    unsigned degree;
+    size_t count;
+    int curves_count;
+    struct MooreCurveOrder curves[MOORE_KNN_MAX_CURVES];
+};
+
+/*
+ * Neighbour found by the query. Distance is squared
+ */
+struct Neighbour {
+    uint64_t distance;
+    uint32_t id;
+};
+
+bool radix_sort_keys(uint32_t* keys, uint32_t* ids, size_t count, int key_bits);
+
+struct MooreKnnIndex* moore_knn_build(unsigned degree, const coord_t* x, const coord_t* y, size_t count, int curves_count);
+
+size_t moore_knn_query(const struct MooreKnnIndex* index, coord_t x, coord_t y, size_t k, size_t window,
+                       struct Neighbour* neighbours);
+
+size_t moore_radius_query(const struct MooreKnnIndex* index, coord_t x, coord_t y, double radius, size_t window,
+                          uint32_t* ids, size_t max_count);
+
+void moore_knn_free(struct MooreKnnIndex* index);
+
+int run_knn_benchmark(unsigned degree, size_t points_count, int queries_count, int k, int window, int curves_count);
+
+#endif // MOORE_CURVE_KNN_H
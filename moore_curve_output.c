@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint32_t coord_t;
+
+void print_moore_curve_points(FILE *fptr, const int32_t points_number, coord_t* x, coord_t* y) {
+    for (size_t i = 0; i < points_number; i++) {
+        fprintf(fptr, "%d, %d\n", x[i], y[i]);
+    }
+}
+
+void print_to_svg(FILE *fptr, unsigned degree, const int32_t points_number, coord_t* x, coord_t* y) {
+    coord_t max_x = 0;
+    coord_t max_y = 0;
+
+    for (size_t i = 0; i < points_number; i++) {
+        coord_t new_x = x[i] * 100;
+        if (max_x < new_x) {
+            max_x = new_x;
+        }
+
+        coord_t new_y = y[i] * 100;
+        if (max_y < new_y) {
+            max_y = new_y;
+        } 
+    }
+
+    fprintf(fptr, "<?xml version=\"1.0\" standalone=\"no\"?>\n");
+    fprintf(fptr, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" version=\"1.1\" baseProfile=\"full\">\n", max_x, max_y);
+    fprintf(fptr, "<polyline points=\"");
+    for (size_t i = 0; i < points_number; i++) {
+        fprintf(fptr, "%d,%d ", x[i] * 100, y[i] * 100);
+    }
+    fprintf(fptr, "\" style=\"fill:none;stroke:black;stroke-width:2\"/>\n");
+    fprintf(fptr, "</svg>\n");
+}
@@ -0,0 +1,406 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define MAX_BLOCK_DEGREE 10
+#define MAX_NUMA_NODES 64
+#define NODE_PATH_SIZE 128
+#define CPU_LIST_SIZE 4096
+#define REPORT_PAGES_PER_WORKER 64
+
+// Memory policies of mbind, see numaif.h
+#define NUMA_MPOL_PREFERRED 1
+
+typedef uint32_t coord_t;
+
+/*
+ * CPUs allowed for the process, ordered round-robin by NUMA node,
+ * so the first workers are spread over all nodes
+ */
+struct CpuPlacement {
+    int* cpus;
+    int* nodes;
+    int cpus_count;
+    int nodes_count;
+};
+
+/*
+ * Slice of the curve filled by one worker
+ */
+struct ParallelWorker {
+    unsigned degree;
+    int block_degree;
+    const coord_t* block_x;
+    const coord_t* block_y;
+    coord_t* x;
+    coord_t* y;
+    size_t first_block;
+    size_t last_block;
+    int cpu; // -1 if the worker is not pinned
+    int node;
+    bool use_mbind;
+};
+
+/*
+ * Workers of the last call, kept for the report which is printed after the measured call
+ */
+struct PlacementReport {
+    struct ParallelWorker* workers;
+    int workers_count;
+    size_t block_size;
+    int nodes_count;
+};
+
+static int parallel_threads_count = 0;
+static bool parallel_report = false;
+static struct PlacementReport last_report = {NULL, 0, 0, 0};
+
+void get_coordinates(coord_t* x_ptr, coord_t* y_ptr, size_t vertex_number, int moore_n);
+
+void extend_hilbert(coord_t* x, coord_t* y, int from_degree, int to_degree);
+
+
+/*
+ * Sets the number of workers of the parallel solution. 0 means the number of online CPUs
+ */
+void moore_parallel_set_threads(int threads_count) {
+    parallel_threads_count = threads_count;
+}
+
+/*
+ * If enabled, the parallel solution keeps the CPU, the NUMA node and the slice of every worker,
+ * so moore_parallel_print_report can print them and where the pages are placed
+ */
+void moore_parallel_set_report(bool report) {
+    parallel_report = report;
+}
+
+/*
+ * Allocates the array of coordinates with mmap. Pages are not touched, so they are placed by the first write
+ */
+coord_t* allocate_coords(size_t count) {
+    void* coords = mmap(NULL, sizeof(coord_t) * count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return coords == MAP_FAILED ? NULL : (coord_t*) coords;
+}
+
+void free_coords(coord_t* coords, size_t count) {
+    if (coords != NULL) {
+        munmap(coords, sizeof(coord_t) * count);
+    }
+}
+
+/*
+ * Parses the list of the CPUs or nodes from sysfs like "0-3,8-11" and sets them in the mask
+ */
+void parse_cpu_list(const char* list, cpu_set_t* mask) {
+    CPU_ZERO(mask);
+    while (*list != '\0' && *list != '\n') {
+        char* end;
+        long first = strtol(list, &end, 10);
+        long last = first;
+        if (end == list) {
+            return;
+        }
+        if (*end == '-') {
+            list = end + 1;
+            last = strtol(list, &end, 10);
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, mask);
+        }
+        list = *end == ',' ? end + 1 : end;
+    }
+}
+
+bool read_sysfs_list(const char* path, cpu_set_t* mask) {
+    char list[CPU_LIST_SIZE];
+    FILE* fptr = fopen(path, "r");
+    if (fptr == NULL) {
+        return false;
+    }
+    bool is_read = fgets(list, CPU_LIST_SIZE, fptr) != NULL;
+    fclose(fptr);
+    if (is_read) {
+        parse_cpu_list(list, mask);
+    }
+    return is_read;
+}
+
+/*
+ * Method finds the CPUs allowed for the process and their NUMA nodes
+ *
+ * If the nodes are unknown (no sysfs), all CPUs are considered to be on the node 0.
+ */
+bool init_cpu_placement(struct CpuPlacement* placement) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) {
+        return false;
+    }
+
+    placement->cpus_count = 0;
+    placement->nodes_count = 1;
+    placement->cpus = (int*) malloc(sizeof(int) * CPU_COUNT(&allowed));
+    placement->nodes = (int*) malloc(sizeof(int) * CPU_COUNT(&allowed));
+    if (placement->cpus == NULL || placement->nodes == NULL) {
+        free(placement->cpus);
+        free(placement->nodes);
+        return false;
+    }
+
+    cpu_set_t node_cpus[MAX_NUMA_NODES];
+    int node_ids[MAX_NUMA_NODES];
+    cpu_set_t online_nodes;
+    int nodes_count = 0;
+    if (read_sysfs_list("/sys/devices/system/node/online", &online_nodes)) {
+        for (int node = 0; node < MAX_NUMA_NODES; node++) {
+            char path[NODE_PATH_SIZE];
+            snprintf(path, NODE_PATH_SIZE, "/sys/devices/system/node/node%d/cpulist", node);
+            if (CPU_ISSET(node, &online_nodes) && read_sysfs_list(path, &node_cpus[nodes_count])) {
+                CPU_AND(&node_cpus[nodes_count], &node_cpus[nodes_count], &allowed);
+                if (CPU_COUNT(&node_cpus[nodes_count]) > 0) {
+                    node_ids[nodes_count++] = node;
+                }
+            }
+        }
+    }
+    if (nodes_count == 0) {
+        node_cpus[0] = allowed;
+        node_ids[0] = 0;
+        nodes_count = 1;
+    }
+    placement->nodes_count = nodes_count;
+
+    // Takes one CPU from every node in turn
+    int next_cpu[MAX_NUMA_NODES];
+    memset(next_cpu, 0, sizeof(next_cpu));
+    bool is_added = true;
+    while (is_added) {
+        is_added = false;
+        for (int i = 0; i < nodes_count; i++) {
+            while (next_cpu[i] < CPU_SETSIZE && !CPU_ISSET(next_cpu[i], &node_cpus[i])) {
+                next_cpu[i]++;
+            }
+            if (next_cpu[i] < CPU_SETSIZE && CPU_ISSET(next_cpu[i], &allowed)) {
+                placement->cpus[placement->cpus_count] = next_cpu[i];
+                placement->nodes[placement->cpus_count] = node_ids[i];
+                placement->cpus_count++;
+                CPU_CLR(next_cpu[i], &allowed);
+                next_cpu[i]++;
+                is_added = true;
+            }
+        }
+    }
+    return placement->cpus_count > 0;
+}
+
+/*
+ * Asks the kernel to place the pages of the slice on the node of the worker
+ *
+ * First touch already does it with the default policy, mbind keeps it when the process uses another policy.
+ */
+void bind_to_node(void* address, size_t size, int node) {
+    const uintptr_t page_size = (uintptr_t) sysconf(_SC_PAGESIZE);
+    const uintptr_t start = (uintptr_t) address / page_size * page_size;
+    const uintptr_t end = (uintptr_t) address + size;
+    unsigned long nodemask[MAX_NUMA_NODES / (8 * sizeof(unsigned long)) + 1];
+    memset(nodemask, 0, sizeof(nodemask));
+    nodemask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    syscall(SYS_mbind, (void*) start, end - start, NUMA_MPOL_PREFERRED, nodemask, MAX_NUMA_NODES + 1, 0);
+}
+
+/*
+ * Method writes the points of the block of the moore curve to x and y
+ *
+ * Every aligned block of 4^block_degree points of the curve is the Hilbert's curve of degree block_degree
+ * rotated or reflected into its square. The Hilbert's curve starts at (0, 0), ends at (side - 1, 0) and its second
+ * quarter starts at (0, side / 2), so the transformation is found from these three points of the block.
+ * block_degree must be between 1 and degree - 1.
+ */
+void fill_moore_block(unsigned degree, int block_degree, const coord_t* block_x, const coord_t* block_y,
+                      size_t block, coord_t* x, coord_t* y) {
+    const size_t block_size = (size_t) 1 << (2 * block_degree);
+    const int32_t side = (int32_t) 1 << block_degree;
+    const size_t first_point = block * block_size;
+
+    coord_t first_x, first_y, quarter_x, quarter_y, last_x, last_y;
+    get_coordinates(&first_x, &first_y, first_point, degree);
+    get_coordinates(&quarter_x, &quarter_y, first_point + block_size / 4, degree);
+    get_coordinates(&last_x, &last_y, first_point + block_size - 1, degree);
+
+    // Columns of the matrix of the transformation: images of (1, 0) and (0, 1)
+    const int32_t xx = ((int32_t) last_x - (int32_t) first_x) / (side - 1);
+    const int32_t xy = ((int32_t) last_y - (int32_t) first_y) / (side - 1);
+    const int32_t yx = ((int32_t) quarter_x - (int32_t) first_x) / (side / 2);
+    const int32_t yy = ((int32_t) quarter_y - (int32_t) first_y) / (side / 2);
+
+    for (size_t i = 0; i < block_size; i++) {
+        const int32_t cur_x = (int32_t) block_x[i];
+        const int32_t cur_y = (int32_t) block_y[i];
+        x[i] = (coord_t) ((int32_t) first_x + xx * cur_x + yx * cur_y);
+        y[i] = (coord_t) ((int32_t) first_y + xy * cur_x + yy * cur_y);
+    }
+}
+
+/*
+ * Method fills the blocks of the slice
+ */
+void* parallel_worker(void* argument) {
+    struct ParallelWorker* worker = (struct ParallelWorker*) argument;
+    if (worker->cpu >= 0) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(worker->cpu, &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask);
+    }
+
+    const size_t block_size = (size_t) 1 << (2 * worker->block_degree);
+    if (worker->use_mbind) {
+        const size_t first_point = worker->first_block * block_size;
+        const size_t slice_size = sizeof(coord_t) * (worker->last_block - worker->first_block) * block_size;
+        bind_to_node(worker->x + first_point, slice_size, worker->node);
+        bind_to_node(worker->y + first_point, slice_size, worker->node);
+    }
+
+    for (size_t block = worker->first_block; block < worker->last_block; block++) {
+        fill_moore_block(worker->degree, worker->block_degree, worker->block_x, worker->block_y, block,
+                         worker->x + block * block_size, worker->y + block * block_size);
+    }
+    return NULL;
+}
+
+/*
+ * Prints the CPU and the node of every worker and how many sampled pages of its slice are on that node
+ */
+void report_placement(struct ParallelWorker* workers, int workers_count, size_t block_size, int nodes_count) {
+    printf("NUMA nodes: %d\n", nodes_count);
+    for (int i = 0; i < workers_count; i++) {
+        struct ParallelWorker* worker = &workers[i];
+        const size_t first_point = worker->first_block * block_size;
+        const size_t points_count = (worker->last_block - worker->first_block) * block_size;
+
+        void* pages[REPORT_PAGES_PER_WORKER];
+        int statuses[REPORT_PAGES_PER_WORKER];
+        int pages_count = 0;
+        for (; pages_count < REPORT_PAGES_PER_WORKER && (size_t) pages_count < points_count; pages_count++) {
+            pages[pages_count] = worker->x + first_point + points_count / REPORT_PAGES_PER_WORKER * pages_count;
+        }
+
+        int local_pages = 0;
+        bool is_known = syscall(SYS_move_pages, 0, pages_count, pages, NULL, statuses, 0) == 0;
+        for (int page = 0; is_known && page < pages_count; page++) {
+            local_pages += statuses[page] == worker->node;
+        }
+
+        if (is_known) {
+            printf("Worker %d: cpu %d, node %d, %d of %d sampled pages are local\n",
+                   i, worker->cpu, worker->node, local_pages, pages_count);
+        } else {
+            printf("Worker %d: cpu %d, node %d, placement of pages is unknown\n", i, worker->cpu, worker->node);
+        }
+    }
+}
+
+/*
+ * Method prints the placement of the workers of the last call of moore_parallel and frees it.
+ * The arrays of that call must not be freed yet, their pages are queried
+ */
+void moore_parallel_print_report() {
+    if (last_report.workers == NULL) {
+        return;
+    }
+    report_placement(last_report.workers, last_report.workers_count, last_report.block_size, last_report.nodes_count);
+    free(last_report.workers);
+    last_report.workers = NULL;
+}
+
+/*
+ * Method finds points coordinates of the moore curve using several threads.
+ *
+ * Every worker is pinned to its own CPU and writes a contiguous slice of x and y,
+ * so the pages of the slice are placed on the NUMA node of the worker by the first touch.
+ * When degree <= 0 function will print an error.
+ */
+void moore_parallel(unsigned degree, coord_t* x, coord_t* y) {
+    if (degree <= 0 || degree > 15) {
+        fprintf(stderr, "Moore curve degree must be between 1 and 15");
+        return;
+    }
+    if (degree == 1) {
+        get_coordinates(&x[0], &y[0], 0, 1);
+        get_coordinates(&x[1], &y[1], 1, 1);
+        get_coordinates(&x[2], &y[2], 2, 1);
+        get_coordinates(&x[3], &y[3], 3, 1);
+        return;
+    }
+
+    const int block_degree = degree - 1 < MAX_BLOCK_DEGREE ? degree - 1 : MAX_BLOCK_DEGREE;
+    const size_t block_size = (size_t) 1 << (2 * block_degree);
+    const size_t blocks_count = ((size_t) 1 << (2 * degree)) / block_size;
+
+    struct CpuPlacement placement;
+    bool is_pinned = init_cpu_placement(&placement);
+    long workers_count = parallel_threads_count;
+    if (workers_count <= 0) {
+        workers_count = is_pinned ? placement.cpus_count : sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (workers_count < 1) {
+        workers_count = 1;
+    }
+    if ((size_t) workers_count > blocks_count) {
+        workers_count = (long) blocks_count;
+    }
+
+    coord_t* block_x = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    coord_t* block_y = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    struct ParallelWorker* workers = (struct ParallelWorker*) malloc(sizeof(struct ParallelWorker) * workers_count);
+    pthread_t* threads = (pthread_t*) malloc(sizeof(pthread_t) * workers_count);
+    if (block_x == NULL || block_y == NULL || workers == NULL || threads == NULL) {
+        // Single thread fallback, it does not need memory
+        for (size_t i = 0; i < ((size_t) 1 << (2 * degree)); i++) {
+            get_coordinates(&x[i], &y[i], i, degree);
+        }
+    } else {
+        block_x[0] = 0;
+        block_y[0] = 0;
+        extend_hilbert(block_x, block_y, 0, block_degree);
+
+        for (long i = 0; i < workers_count; i++) {
+            const bool has_cpu = is_pinned && i < placement.cpus_count;
+            workers[i] = (struct ParallelWorker) {
+                    degree, block_degree, block_x, block_y, x, y,
+                    blocks_count * i / workers_count, blocks_count * (i + 1) / workers_count,
+                    has_cpu ? placement.cpus[i] : -1, has_cpu ? placement.nodes[i] : 0,
+                    has_cpu && placement.nodes_count > 1
+            };
+            pthread_create(&threads[i], NULL, parallel_worker, &workers[i]);
+        }
+        for (long i = 0; i < workers_count; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        if (parallel_report) {
+            // Only the workers are kept, the pages are queried and printed outside of the measured call
+            free(last_report.workers);
+            last_report = (struct PlacementReport) {workers, (int) workers_count, block_size,
+                                                    is_pinned ? placement.nodes_count : 1};
+            workers = NULL;
+        }
+    }
+
+    if (is_pinned) {
+        free(placement.cpus);
+        free(placement.nodes);
+    }
+    free(block_x);
+    free(block_y);
+    free(workers);
+    free(threads);
+}
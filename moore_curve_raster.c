@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define MAX_RASTER_BLOCK_DEGREE 8
+#define BACKGROUND_COLOR 255
+#define LINE_COLOR 0
+// Index of the pixel without points. The indexes of the curves of degrees up to 15 are smaller
+#define NO_POINT UINT32_MAX
+
+typedef uint32_t coord_t;
+
+/*
+ * Image the curve is rendered to
+ *
+ * If the cells of the curve are not smaller than the pixels, the curve is drawn with lines of its segments.
+ * Otherwise every pixel keeps only the index of the first point in it, and its color is the position
+ * of that point along the curve. The points are drawn in the order of the curve, so the first point
+ * is the one that finds the pixel empty, and the image needs 4 bytes per pixel besides its colors.
+ */
+struct Raster {
+    unsigned degree;
+    int width;
+    int height;
+    int channels; // 1 for pgm, 3 for ppm
+    bool is_dense;
+    uint8_t* pixels;
+    uint32_t* first_indexes; // NO_POINT if the pixel is empty
+    // Size of the cell of the curve in pixels when the curve is drawn with lines
+    int cell_width;
+    int cell_height;
+};
+
+void get_coordinates(coord_t* x_ptr, coord_t* y_ptr, size_t vertex_number, int moore_n);
+
+void extend_hilbert(coord_t* x, coord_t* y, int from_degree, int to_degree);
+
+void fill_moore_block(unsigned degree, int block_degree, const coord_t* block_x, const coord_t* block_y,
+                      size_t block, coord_t* x, coord_t* y);
+
+
+/*
+ * Returns the color of the point at the given position (from 0 to 1) along the curve
+ *
+ * Gray images are darker at the start of the curve, color images go through the hues from red to magenta.
+ */
+void position_color(double position, int channels, uint8_t* color) {
+    if (channels == 1) {
+        color[0] = (uint8_t) (220 * position);
+        return;
+    }
+
+    const double hue = 5 * position;
+    const int sector = hue >= 5 ? 4 : (int) hue;
+    const uint8_t rising = (uint8_t) (255 * (hue - sector));
+    const uint8_t falling = 255 - rising;
+    const uint8_t colors[5][3] = {
+            {255, rising, 0},
+            {falling, 255, 0},
+            {0, 255, rising},
+            {0, falling, 255},
+            {rising, 0, 255}
+    };
+    memcpy(color, colors[sector], 3);
+}
+
+/*
+ * Fills the horizontal segment of the row [first_column, last_column] with the color
+ */
+void fill_row(struct Raster* raster, int row, int first_column, int last_column, const uint8_t* color) {
+    uint8_t* pixels = raster->pixels + ((size_t) row * raster->width + first_column) * raster->channels;
+    const int length = last_column - first_column + 1;
+    if (raster->channels == 1) {
+        memset(pixels, color[0], length);
+        return;
+    }
+    for (int i = 0; i < length; i++) {
+        pixels[3 * i] = color[0];
+        pixels[3 * i + 1] = color[1];
+        pixels[3 * i + 2] = color[2];
+    }
+}
+
+/*
+ * Fills the vertical segment of the column [first_row, last_row] with the color
+ */
+void fill_column(struct Raster* raster, int column, int first_row, int last_row, const uint8_t* color) {
+    const size_t stride = (size_t) raster->width * raster->channels;
+    uint8_t* pixels = raster->pixels + ((size_t) first_row * raster->width + column) * raster->channels;
+    for (int row = first_row; row <= last_row; row++, pixels += stride) {
+        memcpy(pixels, color, raster->channels);
+    }
+}
+
+/*
+ * Draws the points of the curve starting from first_index. The segment from the previous point is drawn too
+ */
+void draw_points(struct Raster* raster, const coord_t* x, const coord_t* y, size_t count, size_t first_index,
+                 coord_t* previous_x, coord_t* previous_y) {
+    const coord_t side = (coord_t) 1 << raster->degree;
+    const double points_number = (double) ((size_t) 1 << (2 * raster->degree));
+
+    if (raster->is_dense) {
+        for (size_t i = 0; i < count; i++) {
+            const size_t column = (size_t) x[i] * raster->width / side;
+            const size_t row = (size_t) (side - 1 - y[i]) * raster->height / side;
+            const size_t pixel = row * raster->width + column;
+            if (raster->first_indexes[pixel] == NO_POINT) {
+                raster->first_indexes[pixel] = (uint32_t) (first_index + i);
+            }
+        }
+        return;
+    }
+
+    uint8_t color[3] = {LINE_COLOR, LINE_COLOR, LINE_COLOR};
+    for (size_t i = 0; i < count; i++) {
+        const size_t index = first_index + i;
+        if (index > 0) {
+            if (raster->channels == 3) {
+                position_color(index / points_number, raster->channels, color);
+            }
+
+            // Centers of the cells of the previous and the current points
+            const int previous_column = *previous_x * raster->cell_width + raster->cell_width / 2;
+            const int previous_row = (side - 1 - *previous_y) * raster->cell_height + raster->cell_height / 2;
+            const int column = x[i] * raster->cell_width + raster->cell_width / 2;
+            const int row = (side - 1 - y[i]) * raster->cell_height + raster->cell_height / 2;
+            if (row == previous_row) {
+                fill_row(raster, row, column < previous_column ? column : previous_column,
+                         column < previous_column ? previous_column : column, color);
+            } else {
+                fill_column(raster, column, row < previous_row ? row : previous_row,
+                            row < previous_row ? previous_row : row, color);
+            }
+        }
+        *previous_x = x[i];
+        *previous_y = y[i];
+    }
+}
+
+/*
+ * Converts the first indexes of the pixels to their colors
+ */
+void resolve_first_indexes(struct Raster* raster) {
+    const double points_number = (double) ((size_t) 1 << (2 * raster->degree));
+    const size_t pixels_count = (size_t) raster->width * raster->height;
+    for (size_t pixel = 0; pixel < pixels_count; pixel++) {
+        uint8_t* color = raster->pixels + pixel * raster->channels;
+        if (raster->first_indexes[pixel] != NO_POINT) {
+            position_color(raster->first_indexes[pixel] / points_number, raster->channels, color);
+        }
+    }
+}
+
+bool write_raster(struct Raster* raster, const char* file_name) {
+    FILE* fptr = fopen(file_name, "wb");
+    if (fptr == NULL) {
+        return false;
+    }
+    fprintf(fptr, "%s\n%d %d\n255\n", raster->channels == 1 ? "P5" : "P6", raster->width, raster->height);
+    const size_t size = (size_t) raster->width * raster->height * raster->channels;
+    bool is_written = fwrite(raster->pixels, 1, size, fptr) == size;
+    return fclose(fptr) == 0 && is_written;
+}
+
+bool has_extension(const char* file_name, const char* extension) {
+    const size_t length = strlen(file_name);
+    const size_t extension_length = strlen(extension);
+    return length >= extension_length && strcmp(file_name + length - extension_length, extension) == 0;
+}
+
+void free_raster(struct Raster* raster) {
+    free(raster->pixels);
+    free(raster->first_indexes);
+}
+
+/*
+ * Method renders the moore curve to the pgm image (or ppm image if the file name ends with .ppm)
+ *
+ * Points are generated by blocks and drawn directly, so only the memory of the image and of one block is used.
+ * Returns false if the memory can not be allocated or the file can not be written.
+ */
+bool render_moore_curve(unsigned degree, const char* file_name, int width, int height) {
+    const coord_t side = (coord_t) 1 << degree;
+    struct Raster raster;
+    memset(&raster, 0, sizeof(struct Raster));
+    raster.degree = degree;
+    raster.width = width;
+    raster.height = height;
+    raster.channels = has_extension(file_name, ".ppm") ? 3 : 1;
+    raster.is_dense = side > (coord_t) width || side > (coord_t) height;
+    raster.cell_width = width / side;
+    raster.cell_height = height / side;
+
+    const size_t pixels_count = (size_t) width * height;
+    raster.pixels = (uint8_t*) malloc(pixels_count * raster.channels);
+    if (raster.is_dense) {
+        raster.first_indexes = (uint32_t*) malloc(sizeof(uint32_t) * pixels_count);
+    }
+
+    const int block_degree = degree == 1 ? 0 : (degree - 1 < MAX_RASTER_BLOCK_DEGREE ? degree - 1 : MAX_RASTER_BLOCK_DEGREE);
+    const size_t block_size = (size_t) 1 << (2 * block_degree);
+    coord_t* block_x = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    coord_t* block_y = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    coord_t* x = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    coord_t* y = (coord_t*) malloc(sizeof(coord_t) * block_size);
+    bool is_allocated = raster.pixels != NULL && block_x != NULL && block_y != NULL && x != NULL && y != NULL
+            && (!raster.is_dense || raster.first_indexes != NULL);
+
+    bool is_rendered = false;
+    if (is_allocated) {
+        memset(raster.pixels, BACKGROUND_COLOR, pixels_count * raster.channels);
+        if (raster.is_dense) {
+            memset(raster.first_indexes, 0xFF, sizeof(uint32_t) * pixels_count);
+        }
+        block_x[0] = 0;
+        block_y[0] = 0;
+        extend_hilbert(block_x, block_y, 0, block_degree);
+
+        const size_t blocks_count = ((size_t) 1 << (2 * degree)) / block_size;
+        coord_t previous_x = 0;
+        coord_t previous_y = 0;
+        for (size_t block = 0; block < blocks_count; block++) {
+            if (block_degree == 0) {
+                get_coordinates(x, y, block, degree);
+            } else {
+                fill_moore_block(degree, block_degree, block_x, block_y, block, x, y);
+            }
+            draw_points(&raster, x, y, block_size, block * block_size, &previous_x, &previous_y);
+        }
+
+        if (raster.is_dense) {
+            resolve_first_indexes(&raster);
+        }
+        is_rendered = write_raster(&raster, file_name);
+    }
+
+    free_raster(&raster);
+    free(block_x);
+    free(block_y);
+    free(x);
+    free(y);
+    return is_rendered;
+}
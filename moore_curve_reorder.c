@@ -0,0 +1,251 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "moore_curve_reorder.h"
+#include "moore_curve_walker.h"
+
+/*
+ * Tiles copied by one worker
+ */
+struct ReorderWorker {
+    const struct MooreTile* tiles;
+    size_t first_tile;
+    size_t last_tile;
+    const char* src;
+    char* dst;
+    int width;
+    size_t element_size;
+    int tile_size;
+    bool is_restore;
+};
+
+/*
+ * Tiles grid walked by moore_for_each_tile
+ */
+struct TileWalk {
+    int width;
+    int height;
+    int tile_size;
+    coord_t tiles_width;
+    coord_t tiles_height;
+    unsigned degree;
+    moore_tile_visitor_t visit;
+    void* context;
+    size_t tiles_count;
+};
+
+
+int tiles_count_along(int size, int tile_size) {
+    return (size + tile_size - 1) / tile_size;
+}
+
+/*
+ * Returns the number of elements of the reordered array. Every tile takes tile_size * tile_size elements
+ */
+size_t moore_reordered_size(int width, int height, int tile_size) {
+    return (size_t) tiles_count_along(width, tile_size) * tiles_count_along(height, tile_size) * tile_size * tile_size;
+}
+
+/*
+ * Returns the degree of the smallest curve covering the tiles of the array, or 0 if the walker can not cover them
+ */
+unsigned tiles_curve_degree(int tiles_width, int tiles_height) {
+    unsigned degree = 1;
+    while ((1 << degree) < tiles_width || (1 << degree) < tiles_height) {
+        if (++degree > MOORE_WALKER_MAX_LEVELS) {
+            return 0;
+        }
+    }
+    return degree;
+}
+
+void visit_tile(struct TileWalk* walk, coord_t x, coord_t y) {
+    struct MooreTile tile;
+    tile.index = walk->tiles_count++;
+    tile.column = x * walk->tile_size;
+    tile.row = y * walk->tile_size;
+    tile.width = walk->width - tile.column < walk->tile_size ? walk->width - tile.column : walk->tile_size;
+    tile.height = walk->height - tile.row < walk->tile_size ? walk->height - tile.row : walk->tile_size;
+    walk->visit(&tile, walk->context);
+}
+
+/*
+ * Method visits the tiles of the part of the curve from first to first + 4^level
+ *
+ * Such part fills the aligned square of 2^level tiles. The squares outside the array are skipped,
+ * the squares inside the array are walked point by point, the squares on the border are split into quarters.
+ */
+void walk_tiles_square(struct TileWalk* walk, size_t first, unsigned level) {
+    struct MooreWalker walker;
+    moore_walker_init(&walker, walk->degree, first);
+    coord_t x;
+    coord_t y;
+    moore_walker_point(&walker, &x, &y);
+
+    const coord_t side = (coord_t) 1 << level;
+    const coord_t square_x = x & ~(side - 1);
+    const coord_t square_y = y & ~(side - 1);
+    if (square_x >= walk->tiles_width || square_y >= walk->tiles_height) {
+        return;
+    }
+
+    if (square_x + side <= walk->tiles_width && square_y + side <= walk->tiles_height) {
+        const size_t points_number = (size_t) 1 << (2 * level);
+        for (size_t i = 0; i < points_number; i++) {
+            moore_walker_point(&walker, &x, &y);
+            visit_tile(walk, x, y);
+            moore_walker_next(&walker);
+        }
+        return;
+    }
+
+    const size_t quarter_size = (size_t) 1 << (2 * (level - 1));
+    for (size_t quarter = 0; quarter < 4; quarter++) {
+        walk_tiles_square(walk, first + quarter * quarter_size, level - 1);
+    }
+}
+
+/*
+ * Method visits the tiles of the width x height array in the order of the moore curve
+ *
+ * The curve covers the smallest square of 2^degree tiles containing all tiles, the tiles outside the array are skipped
+ * without walking through them. At most 2^15 tiles along every side are supported.
+ * Returns the number of the visited tiles, or 0 if the array is not supported.
+ */
+size_t moore_for_each_tile(int width, int height, int tile_size, moore_tile_visitor_t visit, void* context) {
+    if (width <= 0 || height <= 0 || tile_size <= 0) {
+        return 0;
+    }
+
+    const int tiles_width = tiles_count_along(width, tile_size);
+    const int tiles_height = tiles_count_along(height, tile_size);
+    const unsigned degree = tiles_curve_degree(tiles_width, tiles_height);
+    if (degree == 0) {
+        return 0;
+    }
+
+    struct TileWalk walk = {
+            width, height, tile_size, (coord_t) tiles_width, (coord_t) tiles_height, degree, visit, context, 0
+    };
+    walk_tiles_square(&walk, 0, degree);
+    return walk.tiles_count;
+}
+
+void save_tile(const struct MooreTile* tile, void* context) {
+    struct MooreTile* tiles = (struct MooreTile*) context;
+    tiles[tile->index] = *tile;
+}
+
+/*
+ * Copies the rows of the tile between the row-major array and the row-major tile of the reordered array
+ */
+void copy_tile(const struct ReorderWorker* worker, const struct MooreTile* tile) {
+    const size_t row_size = worker->element_size * tile->width;
+    const size_t tile_row_size = worker->element_size * worker->tile_size;
+    const size_t array_row_size = worker->element_size * worker->width;
+    const size_t tile_offset = tile->index * tile_row_size * worker->tile_size;
+    const size_t array_offset = tile->row * array_row_size + worker->element_size * tile->column;
+
+    for (int row = 0; row < tile->height; row++) {
+        const size_t tile_row_offset = tile_offset + row * tile_row_size;
+        const size_t array_row_offset = array_offset + row * array_row_size;
+        if (worker->is_restore) {
+            memcpy(worker->dst + array_row_offset, worker->src + tile_row_offset, row_size);
+        } else {
+            memcpy(worker->dst + tile_row_offset, worker->src + array_row_offset, row_size);
+            // Padding of the border tiles is zeroed, so the reordered array does not contain garbage
+            memset(worker->dst + tile_row_offset + row_size, 0, tile_row_size - row_size);
+        }
+    }
+    if (!worker->is_restore && tile->height < worker->tile_size) {
+        memset(worker->dst + tile_offset + tile->height * tile_row_size, 0, (worker->tile_size - tile->height) * tile_row_size);
+    }
+}
+
+void* reorder_worker(void* argument) {
+    const struct ReorderWorker* worker = (const struct ReorderWorker*) argument;
+    for (size_t tile = worker->first_tile; tile < worker->last_tile; tile++) {
+        copy_tile(worker, &worker->tiles[tile]);
+    }
+    return NULL;
+}
+
+/*
+ * Method copies the tiles between the arrays on several threads. Every thread copies a contiguous range of tiles
+ */
+bool reorder_tiles(const void* src, void* dst, int width, int height, size_t element_size, int tile_size,
+                   int threads_count, bool is_restore) {
+    if (width <= 0 || height <= 0 || tile_size <= 0 || element_size == 0) {
+        return false;
+    }
+
+    const size_t tiles_count = (size_t) tiles_count_along(width, tile_size) * tiles_count_along(height, tile_size);
+    if (threads_count <= 0) {
+        threads_count = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads_count < 1) {
+        threads_count = 1;
+    }
+    if ((size_t) threads_count > tiles_count) {
+        threads_count = (int) tiles_count;
+    }
+
+    struct MooreTile* tiles = (struct MooreTile*) malloc(sizeof(struct MooreTile) * tiles_count);
+    struct ReorderWorker* workers = (struct ReorderWorker*) malloc(sizeof(struct ReorderWorker) * threads_count);
+    pthread_t* threads = (pthread_t*) malloc(sizeof(pthread_t) * threads_count);
+    if (tiles == NULL || workers == NULL || threads == NULL) {
+        free(tiles);
+        free(workers);
+        free(threads);
+        return false;
+    }
+
+    // Every tile must be visited, otherwise its slot is not initialized
+    if (moore_for_each_tile(width, height, tile_size, save_tile, tiles) != tiles_count) {
+        free(tiles);
+        free(workers);
+        free(threads);
+        return false;
+    }
+    for (int i = 0; i < threads_count; i++) {
+        workers[i] = (struct ReorderWorker) {
+                tiles, tiles_count * i / threads_count, tiles_count * (i + 1) / threads_count,
+                (const char*) src, (char*) dst, width, element_size, tile_size, is_restore
+        };
+    }
+    // The current thread is one of the workers
+    for (int i = 1; i < threads_count; i++) {
+        pthread_create(&threads[i], NULL, reorder_worker, &workers[i]);
+    }
+    reorder_worker(&workers[0]);
+    for (int i = 1; i < threads_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(tiles);
+    free(workers);
+    free(threads);
+    return true;
+}
+
+/*
+ * Method copies the row-major width x height array of elements to dst as tile_size x tile_size tiles
+ * in the order of the moore curve
+ *
+ * Every tile is row-major and takes tile_size * tile_size elements in dst, see moore_reordered_size.
+ * threads_count <= 0 means the number of online CPUs.
+ */
+bool moore_reorder(const void* src, void* dst, int width, int height, size_t element_size, int tile_size, int threads_count) {
+    return reorder_tiles(src, dst, width, height, element_size, tile_size, threads_count, false);
+}
+
+/*
+ * Method copies the tiles reordered by moore_reorder back to the row-major width x height array
+ */
+bool moore_restore(const void* src, void* dst, int width, int height, size_t element_size, int tile_size, int threads_count) {
+    return reorder_tiles(src, dst, width, height, element_size, tile_size, threads_count, true);
+}
@@ -0,0 +1,28 @@
+#ifndef MOORE_CURVE_REORDER_H
+#define MOORE_CURVE_REORDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Tile of the row-major array. Tiles on the right and bottom borders can be smaller than tile_size
+ */
+struct MooreTile {
+    size_t index; // position of the tile along the moore curve
+    int column; // first column of the tile in the array
+    int row; // first row of the tile in the array
+    int width;
+    int height;
+};
+
+typedef void (*moore_tile_visitor_t)(const struct MooreTile* tile, void* context);
+
+size_t moore_reordered_size(int width, int height, int tile_size);
+
+size_t moore_for_each_tile(int width, int height, int tile_size, moore_tile_visitor_t visit, void* context);
+
+bool moore_reorder(const void* src, void* dst, int width, int height, size_t element_size, int tile_size, int threads_count);
+
+bool moore_restore(const void* src, void* dst, int width, int height, size_t element_size, int tile_size, int threads_count);
+
+#endif // MOORE_CURVE_REORDER_H
@@ -0,0 +1,664 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "moore_curve_server.h"
+
+#define MAX_DEGREE 15
+#define MAX_EVENTS 64
+#define MAX_BATCH_SIZE (1 << 20)
+#define MAX_RECT_RANGES (1 << 20)
+// Connections receive the requests by chunks of this size
+#define RECEIVE_CHUNK_SIZE 65536
+
+typedef uint32_t coord_t;
+
+/*
+ * Client connection. The event loop receives the bytes of the requests to the buffer,
+ * and the connection is passed to the workers only when the whole request is received.
+ * The response is written to the output buffer, the part that the client does not read yet is sent by the event loop.
+ */
+struct Connection {
+    int fd;
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;
+    uint8_t* output;
+    size_t output_capacity;
+    size_t output_size;
+    size_t output_sent;
+    bool is_closing; // the connection is closed when the output is sent
+};
+
+/*
+ * Buffers of the worker reused by all its requests
+ */
+struct WorkerBuffers {
+    struct IndexRange* ranges;
+};
+
+/*
+ * Queue of the connections with the received requests which are waiting for the workers
+ */
+struct ClientQueue {
+    struct Connection** connections;
+    size_t capacity;
+    size_t head;
+    size_t size;
+    bool stopped;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+};
+
+/*
+ * State shared by the event loop and the workers
+ */
+struct Server {
+    int epoll_fd;
+    struct ClientQueue queue;
+    pthread_mutex_t curves_mutex;
+    pthread_cond_t curve_is_ready;
+    bool curve_is_calculated[MAX_DEGREE + 1]; // the curve is being calculated by some worker
+    coord_t* curve_x[MAX_DEGREE + 1];
+    coord_t* curve_y[MAX_DEGREE + 1];
+};
+
+void moore(unsigned degree, coord_t* x, coord_t* y);
+
+bool malloc_is_failed();
+
+void get_coordinates(coord_t* x_ptr, coord_t* y_ptr, size_t vertex_number, int moore_n);
+
+size_t get_index(coord_t x, coord_t y, int moore_n);
+
+
+static volatile sig_atomic_t server_is_stopped = 0;
+
+void stop_server(int signal) {
+    server_is_stopped = 1;
+}
+
+/*
+ * Method sends the unsent part of the output without blocking. Returns false if the connection is broken
+ */
+bool send_pending(struct Connection* connection) {
+    while (connection->output_sent < connection->output_size) {
+        ssize_t sent = send(connection->fd, connection->output + connection->output_sent,
+                            connection->output_size - connection->output_sent, MSG_NOSIGNAL);
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) continue;
+            return false;
+        }
+        connection->output_sent += sent;
+    }
+    connection->output_size = 0;
+    connection->output_sent = 0;
+    return true;
+}
+
+/*
+ * Returns the size of the payload of the request or false if the header is invalid
+ */
+bool request_payload_size(const struct ServerRequest* request, size_t* size) {
+    if (request->count > MAX_BATCH_SIZE) {
+        return false;
+    }
+    switch (request->operation) {
+        case OPERATION_INDEX_TO_POINT: *size = sizeof(uint32_t) * request->count; return true;
+        case OPERATION_POINT_TO_INDEX: *size = 2 * sizeof(uint32_t) * request->count; return true;
+        case OPERATION_INDEX_RANGE: *size = sizeof(uint32_t); return true;
+        case OPERATION_RECT_TO_RANGES: *size = 4 * sizeof(uint32_t); return true;
+        default: return false;
+    }
+}
+
+/*
+ * Returns true if the buffer of the connection contains the whole request. Its size is written to [request_size]
+ *
+ * The request with the invalid header is complete after the header, it is answered and the connection is closed.
+ */
+bool has_complete_request(const struct Connection* connection, size_t* request_size, bool* is_valid) {
+    if (connection->size < sizeof(struct ServerRequest)) {
+        *request_size = sizeof(struct ServerRequest);
+        return false;
+    }
+    struct ServerRequest request;
+    memcpy(&request, connection->buffer, sizeof(struct ServerRequest));
+    size_t payload_size = 0;
+    *is_valid = request_payload_size(&request, &payload_size);
+    *request_size = sizeof(struct ServerRequest) + payload_size;
+    return connection->size >= *request_size;
+}
+
+void close_connection(struct Connection* connection) {
+    close(connection->fd);
+    free(connection->buffer);
+    free(connection->output);
+    free(connection);
+}
+
+/*
+ * Method receives the available bytes of the connection until the whole request is received
+ *
+ * Returns false if the client closed the connection or the memory can not be allocated.
+ */
+bool receive_request(struct Connection* connection) {
+    size_t request_size;
+    bool is_valid;
+    while (!has_complete_request(connection, &request_size, &is_valid)) {
+        const size_t needed = request_size > connection->size + RECEIVE_CHUNK_SIZE ? request_size : connection->size + RECEIVE_CHUNK_SIZE;
+        if (connection->capacity < needed) {
+            uint8_t* new_buffer = (uint8_t*) realloc(connection->buffer, needed);
+            if (new_buffer == NULL) {
+                return false;
+            }
+            connection->buffer = new_buffer;
+            connection->capacity = needed;
+        }
+
+        ssize_t received = recv(connection->fd, connection->buffer + connection->size,
+                                connection->capacity - connection->size, 0);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) continue;
+            return false;
+        }
+        connection->size += received;
+    }
+    return true;
+}
+
+bool push_client(struct ClientQueue* queue, struct Connection* connection) {
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->size == queue->capacity) {
+        size_t new_capacity = queue->capacity == 0 ? 64 : 2 * queue->capacity;
+        struct Connection** new_connections = (struct Connection**) malloc(sizeof(struct Connection*) * new_capacity);
+        if (new_connections == NULL) {
+            pthread_mutex_unlock(&queue->mutex);
+            return false;
+        }
+        for (size_t i = 0; i < queue->size; i++) {
+            new_connections[i] = queue->connections[(queue->head + i) % queue->capacity];
+        }
+        free(queue->connections);
+        queue->connections = new_connections;
+        queue->capacity = new_capacity;
+        queue->head = 0;
+    }
+    queue->connections[(queue->head + queue->size) % queue->capacity] = connection;
+    queue->size++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->mutex);
+    return true;
+}
+
+/*
+ * Returns the next connection with the received request or NULL if the server is stopped
+ */
+struct Connection* pop_client(struct ClientQueue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->size == 0 && !queue->stopped) {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);
+    }
+    struct Connection* connection = NULL;
+    if (queue->size > 0) {
+        connection = queue->connections[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->size--;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return connection;
+}
+
+/*
+ * Returns the resident points of the moore curve, they are calculated by the first request of the degree
+ *
+ * The curve is calculated without the lock, so the requests of other degrees are not blocked.
+ * The requests of the same degree wait until the curve is ready.
+ */
+bool get_resident_curve(struct Server* server, unsigned degree, coord_t** x, coord_t** y) {
+    pthread_mutex_lock(&server->curves_mutex);
+    while (server->curve_is_calculated[degree]) {
+        pthread_cond_wait(&server->curve_is_ready, &server->curves_mutex);
+    }
+    if (server->curve_x[degree] != NULL) {
+        *x = server->curve_x[degree];
+        *y = server->curve_y[degree];
+        pthread_mutex_unlock(&server->curves_mutex);
+        return true;
+    }
+    server->curve_is_calculated[degree] = true;
+    pthread_mutex_unlock(&server->curves_mutex);
+
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    coord_t* new_x = (coord_t*) malloc(sizeof(coord_t) * points_number);
+    coord_t* new_y = (coord_t*) malloc(sizeof(coord_t) * points_number);
+    if (new_x != NULL && new_y != NULL) {
+        moore(degree, new_x, new_y);
+    }
+    const bool is_calculated = new_x != NULL && new_y != NULL && !malloc_is_failed();
+    if (!is_calculated) {
+        free(new_x);
+        free(new_y);
+    }
+
+    pthread_mutex_lock(&server->curves_mutex);
+    if (is_calculated) {
+        server->curve_x[degree] = new_x;
+        server->curve_y[degree] = new_y;
+        *x = new_x;
+        *y = new_y;
+    }
+    server->curve_is_calculated[degree] = false;
+    pthread_cond_broadcast(&server->curve_is_ready);
+    pthread_mutex_unlock(&server->curves_mutex);
+    return is_calculated;
+}
+
+/*
+ * Method adds the index ranges of the square with the side size and the lower left corner (square_x, square_y)
+ * which intersect the rectangle
+ *
+ * Every aligned square with power of two side is a contiguous range of the curve, so the squares that are
+ * inside the rectangle are added as a whole, and the squares that intersect its border are divided into 4 parts.
+ */
+bool add_rect_ranges(unsigned degree, coord_t square_x, coord_t square_y, coord_t size, const coord_t* rect,
+                     struct IndexRange* ranges, uint32_t* ranges_count) {
+    const coord_t square_x1 = square_x + size - 1;
+    const coord_t square_y1 = square_y + size - 1;
+    if (square_x > rect[2] || square_x1 < rect[0] || square_y > rect[3] || square_y1 < rect[1]) {
+        return true;
+    }
+
+    if (square_x >= rect[0] && square_x1 <= rect[2] && square_y >= rect[1] && square_y1 <= rect[3]) {
+        if (*ranges_count == MAX_RECT_RANGES) {
+            return false;
+        }
+        const uint32_t area = size * size;
+        const uint32_t start = (uint32_t) get_index(square_x, square_y, degree) & ~(area - 1);
+        ranges[(*ranges_count)++] = (struct IndexRange) {start, start + area};
+        return true;
+    }
+
+    const coord_t half = size / 2;
+    return add_rect_ranges(degree, square_x, square_y, half, rect, ranges, ranges_count)
+            && add_rect_ranges(degree, square_x, square_y + half, half, rect, ranges, ranges_count)
+            && add_rect_ranges(degree, square_x + half, square_y, half, rect, ranges, ranges_count)
+            && add_rect_ranges(degree, square_x + half, square_y + half, half, rect, ranges, ranges_count);
+}
+
+int compare_ranges(const void* lhs, const void* rhs) {
+    const struct IndexRange* lhs_range = (const struct IndexRange*) lhs;
+    const struct IndexRange* rhs_range = (const struct IndexRange*) rhs;
+    return (lhs_range->start > rhs_range->start) - (lhs_range->start < rhs_range->start);
+}
+
+/*
+ * Method finds the sorted and merged index ranges covering the rectangle
+ */
+uint32_t rect_to_ranges(unsigned degree, const coord_t* rect, struct IndexRange* ranges, bool* is_overflowed) {
+    uint32_t ranges_count = 0;
+    *is_overflowed = !add_rect_ranges(degree, 0, 0, (coord_t) 1 << degree, rect, ranges, &ranges_count);
+    qsort(ranges, ranges_count, sizeof(struct IndexRange), compare_ranges);
+
+    uint32_t merged_count = 0;
+    for (uint32_t i = 0; i < ranges_count; i++) {
+        if (merged_count > 0 && ranges[merged_count - 1].end == ranges[i].start) {
+            ranges[merged_count - 1].end = ranges[i].end;
+        } else {
+            ranges[merged_count++] = ranges[i];
+        }
+    }
+    return merged_count;
+}
+
+/*
+ * Method reserves the output of the connection for the response header and the payload of the given number of bytes.
+ * Returns the payload of the response
+ */
+uint32_t* reserve_response(struct Connection* connection, size_t size) {
+    const size_t needed = sizeof(struct ServerResponse) + size;
+    if (connection->output_capacity < needed) {
+        uint8_t* new_output = (uint8_t*) realloc(connection->output, needed);
+        if (new_output == NULL) {
+            return NULL;
+        }
+        connection->output = new_output;
+        connection->output_capacity = needed;
+    }
+    return (uint32_t*) (connection->output + sizeof(struct ServerResponse));
+}
+
+/*
+ * Method calculates the response payload of the received request
+ *
+ * Returns the status of the response. The payload is written to the output of the connection after the header.
+ */
+uint32_t process_request(struct Server* server, struct WorkerBuffers* buffers, struct Connection* connection,
+                         const struct ServerRequest* request, const uint32_t* payload, size_t* response_size,
+                         uint32_t* response_count) {
+    const unsigned degree = request->degree;
+    if (degree < 1 || degree > MAX_DEGREE) {
+        return STATUS_INVALID_REQUEST;
+    }
+    const coord_t side = (coord_t) 1 << degree;
+    const size_t points_number = (size_t) 1 << (2 * degree);
+
+    uint32_t* result = NULL;
+    *response_count = request->count;
+    switch (request->operation) {
+        case OPERATION_INDEX_TO_POINT:
+            *response_size = 2 * sizeof(uint32_t) * request->count;
+            result = reserve_response(connection, *response_size);
+            if (result == NULL) {
+                return STATUS_FAILED_MALLOC;
+            }
+            for (uint32_t i = 0; i < request->count; i++) {
+                if (payload[i] >= points_number) {
+                    return STATUS_INVALID_REQUEST;
+                }
+                get_coordinates(&result[2 * i], &result[2 * i + 1], payload[i], degree);
+            }
+            break;
+        case OPERATION_POINT_TO_INDEX:
+            *response_size = sizeof(uint32_t) * request->count;
+            result = reserve_response(connection, *response_size);
+            if (result == NULL) {
+                return STATUS_FAILED_MALLOC;
+            }
+            for (uint32_t i = 0; i < request->count; i++) {
+                if (payload[2 * i] >= side || payload[2 * i + 1] >= side) {
+                    return STATUS_INVALID_REQUEST;
+                }
+                result[i] = (uint32_t) get_index(payload[2 * i], payload[2 * i + 1], degree);
+            }
+            break;
+        case OPERATION_INDEX_RANGE: {
+            coord_t* x;
+            coord_t* y;
+            if (payload[0] >= points_number || request->count > points_number - payload[0]) {
+                return STATUS_INVALID_REQUEST;
+            }
+            if (!get_resident_curve(server, degree, &x, &y)) {
+                return STATUS_FAILED_MALLOC;
+            }
+            *response_size = 2 * sizeof(uint32_t) * request->count;
+            result = reserve_response(connection, *response_size);
+            if (result == NULL) {
+                return STATUS_FAILED_MALLOC;
+            }
+            for (uint32_t i = 0; i < request->count; i++) {
+                result[2 * i] = x[payload[0] + i];
+                result[2 * i + 1] = y[payload[0] + i];
+            }
+            break;
+        }
+        case OPERATION_RECT_TO_RANGES: {
+            if (payload[0] > payload[2] || payload[1] > payload[3] || payload[2] >= side || payload[3] >= side) {
+                return STATUS_INVALID_REQUEST;
+            }
+            if (buffers->ranges == NULL) {
+                buffers->ranges = (struct IndexRange*) malloc(sizeof(struct IndexRange) * MAX_RECT_RANGES);
+                if (buffers->ranges == NULL) {
+                    return STATUS_FAILED_MALLOC;
+                }
+            }
+            bool is_overflowed;
+            *response_count = rect_to_ranges(degree, payload, buffers->ranges, &is_overflowed);
+            *response_size = sizeof(struct IndexRange) * (*response_count);
+            if (is_overflowed) {
+                return STATUS_INVALID_REQUEST;
+            }
+            result = reserve_response(connection, *response_size);
+            if (result == NULL) {
+                return STATUS_FAILED_MALLOC;
+            }
+            memcpy(result, buffers->ranges, *response_size);
+            break;
+        }
+    }
+    return STATUS_OK;
+}
+
+/*
+ * Method serves the received requests of the connection. Returns false if the connection must be closed
+ *
+ * The response is sent without blocking. If the client does not read it, the worker stops serving the connection
+ * and the event loop sends the rest of the response when the socket is writable.
+ */
+bool serve_client(struct Server* server, struct WorkerBuffers* buffers, struct Connection* connection) {
+    size_t request_size;
+    bool is_valid;
+    while (connection->output_size == 0 && !connection->is_closing
+            && has_complete_request(connection, &request_size, &is_valid)) {
+        struct ServerRequest request;
+        memcpy(&request, connection->buffer, sizeof(struct ServerRequest));
+
+        size_t response_size = 0;
+        uint32_t response_count = 0;
+        struct ServerResponse response;
+        response.status = STATUS_INVALID_REQUEST;
+        if (is_valid) {
+            // The payload follows the 12 bytes of the header, so it is aligned for uint32_t
+            const uint32_t* payload = (const uint32_t*) (connection->buffer + sizeof(struct ServerRequest));
+            response.status = process_request(server, buffers, connection, &request, payload,
+                                              &response_size, &response_count);
+        }
+        if (response.status != STATUS_OK) {
+            response_size = 0;
+            response_count = 0;
+        }
+        response.count = response_count;
+        if (reserve_response(connection, response_size) == NULL) {
+            return false;
+        }
+        memcpy(connection->output, &response, sizeof(struct ServerResponse));
+        connection->output_size = sizeof(struct ServerResponse) + response_size;
+
+        if (is_valid) {
+            connection->size -= request_size;
+            memmove(connection->buffer, connection->buffer + request_size, connection->size);
+        } else {
+            // The payload of the invalid header is unknown, so the rest of the stream can not be parsed
+            connection->is_closing = true;
+        }
+        if (!send_pending(connection)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Method returns the connection to the event loop. The loop waits until the socket is writable if a part
+ * of the response is not sent, otherwise until the next bytes of the requests. Returns false if the connection
+ * must be closed
+ */
+bool rearm_connection(struct Server* server, struct Connection* connection) {
+    if (connection->output_size == 0 && connection->is_closing) {
+        return false;
+    }
+    // Client socket is registered with EPOLLONESHOT, so only one thread handles the connection at a time
+    struct epoll_event event = {
+            .events = (connection->output_size > 0 ? EPOLLOUT : EPOLLIN) | EPOLLONESHOT, .data.ptr = connection
+    };
+    return epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) == 0;
+}
+
+void* server_worker(void* argument) {
+    struct Server* server = (struct Server*) argument;
+    struct WorkerBuffers buffers = {NULL};
+    struct Connection* connection;
+    while ((connection = pop_client(&server->queue)) != NULL) {
+        if (!serve_client(server, &buffers, connection) || !rearm_connection(server, connection)) {
+            close_connection(connection);
+        }
+    }
+    free(buffers.ranges);
+    return NULL;
+}
+
+/*
+ * Method continues the ready connection in the event loop. The rest of the response is sent first,
+ * then the bytes of the requests are received. The connection is passed to the workers when the whole request
+ * is received, otherwise it waits for the next bytes
+ */
+void on_client_ready(struct Server* server, struct Connection* connection) {
+    size_t request_size;
+    bool is_valid;
+    if (!send_pending(connection)) {
+        close_connection(connection);
+        return;
+    }
+    if (connection->output_size == 0 && !connection->is_closing) {
+        if (!receive_request(connection)) {
+            close_connection(connection);
+            return;
+        }
+        if (has_complete_request(connection, &request_size, &is_valid)) {
+            if (!push_client(&server->queue, connection)) {
+                close_connection(connection);
+            }
+            return;
+        }
+    }
+    if (!rearm_connection(server, connection)) {
+        close_connection(connection);
+    }
+}
+
+void accept_clients(struct Server* server, int listen_fd) {
+    int client_fd;
+    while ((client_fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK)) >= 0) {
+        struct Connection* connection = (struct Connection*) calloc(1, sizeof(struct Connection));
+        if (connection == NULL) {
+            close(client_fd);
+            continue;
+        }
+        connection->fd = client_fd;
+        struct epoll_event client_event = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = connection};
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event) != 0) {
+            close_connection(connection);
+        }
+    }
+}
+
+int open_server_socket(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(struct sockaddr_un));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr*) &address, sizeof(struct sockaddr_un)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Method runs the daemon which answers the requests on the unix domain socket until SIGINT or SIGTERM
+ *
+ * The event loop receives the requests from the non-blocking client sockets with epoll and passes the connections
+ * with the whole requests to the pool of workers, so a client which sends a part of the request never holds a worker.
+ * The workers do not wait for the clients to read the responses either, the unsent parts are sent by the event loop.
+ */
+int serve_moore_curve(const char* socket_path) {
+    struct Server server;
+    memset(&server, 0, sizeof(struct Server));
+    pthread_mutex_init(&server.queue.mutex, NULL);
+    pthread_cond_init(&server.queue.not_empty, NULL);
+    pthread_mutex_init(&server.curves_mutex, NULL);
+    pthread_cond_init(&server.curve_is_ready, NULL);
+
+    int listen_fd = open_server_socket(socket_path);
+    if (listen_fd < 0) {
+        return -1;
+    }
+
+    server.epoll_fd = epoll_create1(0);
+    // The listening socket is the only one registered without a connection
+    struct epoll_event listen_event = {.events = EPOLLIN, .data.ptr = NULL};
+    if (server.epoll_fd < 0 || epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) != 0) {
+        close(listen_fd);
+        unlink(socket_path);
+        return -1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(struct sigaction));
+    action.sa_handler = stop_server;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    long workers_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (workers_count < 1) {
+        workers_count = 1;
+    }
+    pthread_t* workers = (pthread_t*) malloc(sizeof(pthread_t) * workers_count);
+    if (workers == NULL) {
+        close(listen_fd);
+        unlink(socket_path);
+        return -1;
+    }
+    for (long i = 0; i < workers_count; i++) {
+        pthread_create(&workers[i], NULL, server_worker, &server);
+    }
+    printf("Serving on %s with %ld workers\n", socket_path, workers_count);
+    fflush(stdout);
+
+    struct epoll_event events[MAX_EVENTS];
+    while (!server_is_stopped) {
+        int events_count = epoll_wait(server.epoll_fd, events, MAX_EVENTS, -1);
+        for (int i = 0; i < events_count; i++) {
+            if (events[i].data.ptr == NULL) {
+                accept_clients(&server, listen_fd);
+            } else {
+                on_client_ready(&server, (struct Connection*) events[i].data.ptr);
+            }
+        }
+    }
+
+    pthread_mutex_lock(&server.queue.mutex);
+    server.queue.stopped = true;
+    pthread_cond_broadcast(&server.queue.not_empty);
+    pthread_mutex_unlock(&server.queue.mutex);
+    for (long i = 0; i < workers_count; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    close(listen_fd);
+    close(server.epoll_fd);
+    unlink(socket_path);
+    for (int degree = 0; degree <= MAX_DEGREE; degree++) {
+        free(server.curve_x[degree]);
+        free(server.curve_y[degree]);
+    }
+    free(server.queue.connections);
+    free(workers);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#ifndef MOORE_CURVE_SERVER_H
+#define MOORE_CURVE_SERVER_H
+
+#include <stdint.h>
+
+// Operations of the requests
+#define OPERATION_INDEX_TO_POINT 0
+#define OPERATION_POINT_TO_INDEX 1
+#define OPERATION_INDEX_RANGE 2
+#define OPERATION_RECT_TO_RANGES 3
+
+// Statuses of the responses
+#define STATUS_OK 0
+#define STATUS_INVALID_REQUEST 1
+#define STATUS_FAILED_MALLOC 2
+
+/*
+ * Header of the request. It is followed by the payload:
+ *
+ * OPERATION_INDEX_TO_POINT - count indexes, the response contains count pairs (x, y)
+ * OPERATION_POINT_TO_INDEX - count pairs (x, y), the response contains count indexes
+ * OPERATION_INDEX_RANGE    - the first index, the response contains count pairs (x, y) starting from it
+ * OPERATION_RECT_TO_RANGES - x0, y0, x1, y1 of the rectangle (inclusive), count is ignored;
+ *                            the response contains pairs [start, end) of index ranges covering the rectangle
+ *
+ * All numbers are uint32_t in the native byte order.
+ */
+struct ServerRequest {
+    uint32_t operation;
+    uint32_t degree;
+    uint32_t count;
+};
+
+/*
+ * Header of the response. It is followed by count items of the operation
+ */
+struct ServerResponse {
+    uint32_t status;
+    uint32_t count;
+};
+
+/*
+ * Range [start, end) of the indexes
+ */
+struct IndexRange {
+    uint32_t start;
+    uint32_t end;
+};
+
+int serve_moore_curve(const char* socket_path);
+
+int load_test_moore_curve(const char* socket_path, unsigned degree, int requests_count, uint32_t batch_size);
+
+#endif // MOORE_CURVE_SERVER_H
@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Number of points hashed together. Hashes of the blocks locate the first differing point
+#define VERIFY_BLOCK_SIZE 65536
+#define HASH_LANES 4
+#define REFERENCE_SOLUTION 0
+// Value of first_mismatch when no point of the mismatching block differs from the reference solution
+#define NO_MISMATCH SIZE_MAX
+
+// Primes of xxHash64
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+
+typedef uint32_t coord_t;
+
+/*
+ * Result of the streaming pass over the points of one solution
+ */
+struct VerifyResult {
+    uint64_t hash;
+    size_t broken_steps; // steps that are not unit moves, including the step from the last point to the first one
+    size_t first_broken_step; // index of the point the first broken step goes to
+    bool has_mismatch;
+    size_t mismatch_block; // first index of the first block whose hash differs from the reference solution
+    size_t first_mismatch; // first index where the points differ from the reference solution, or NO_MISMATCH
+};
+
+static const char* const solution_names[] = {
+        "iterative", "gray code", "recursive", "incremental", "parallel", "gray code walker"
+};
+
+double calc_moore_curve_points(unsigned degree, coord_t* x, coord_t* y, int solution_type, bool with_benchmarking);
+
+bool malloc_is_failed();
+
+coord_t* allocate_coords(size_t count);
+
+void free_coords(coord_t* coords, size_t count);
+
+
+static inline uint64_t rotate_left(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t hash_round(uint64_t accumulator, uint64_t input) {
+    return rotate_left(accumulator + input * PRIME64_2, 31) * PRIME64_1;
+}
+
+/*
+ * Method hashes the block of points, every point is the 64 bit word (y << 32 | x)
+ *
+ * The points are dealt to 4 independent lanes like in xxHash64. Every lane is a separate scalar chain
+ * of 64 bit multiplications, so the processor overlaps the multiplications of the lanes instead of waiting
+ * for each of them. The loop is not vectorized: the default target has no 64 bit vector multiplication.
+ * The size of the block must be a multiple of 4.
+ */
+uint64_t hash_points(const coord_t* x, const coord_t* y, size_t count, uint64_t seed) {
+    uint64_t lanes[HASH_LANES] = {seed + PRIME64_1 + PRIME64_2, seed + PRIME64_2, seed, seed - PRIME64_1};
+    for (size_t i = 0; i < count; i += HASH_LANES) {
+        for (int lane = 0; lane < HASH_LANES; lane++) {
+            lanes[lane] = hash_round(lanes[lane], ((uint64_t) y[i + lane] << 32) | x[i + lane]);
+        }
+    }
+
+    uint64_t hash = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7) + rotate_left(lanes[2], 12) + rotate_left(lanes[3], 18);
+    for (int lane = 0; lane < HASH_LANES; lane++) {
+        hash = (hash ^ hash_round(0, lanes[lane])) * PRIME64_1 + PRIME64_4;
+    }
+    hash += count;
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static inline bool is_unit_step(coord_t from_x, coord_t from_y, coord_t to_x, coord_t to_y) {
+    const int64_t dx = (int64_t) to_x - from_x;
+    const int64_t dy = (int64_t) to_y - from_y;
+    return dx * dx + dy * dy == 1;
+}
+
+/*
+ * Method counts the steps of the block that are not unit moves. Step i goes from the point i - 1 to the point i
+ */
+size_t count_broken_steps(const coord_t* x, const coord_t* y, size_t first, size_t last, size_t* first_broken_step) {
+    size_t broken_steps = 0;
+    for (size_t i = first; i < last; i++) {
+        broken_steps += !is_unit_step(x[i - 1], y[i - 1], x[i], y[i]);
+    }
+    if (broken_steps > 0 && *first_broken_step == 0) {
+        for (size_t i = first; i < last; i++) {
+            if (!is_unit_step(x[i - 1], y[i - 1], x[i], y[i])) {
+                *first_broken_step = i;
+                break;
+            }
+        }
+    }
+    return broken_steps;
+}
+
+/*
+ * Method finds the first point of the block that differs from the point of the reference solution.
+ * Returns NO_MISMATCH if all points of the block are equal
+ */
+size_t find_first_mismatch(const coord_t* x, const coord_t* y, const coord_t* reference_x, const coord_t* reference_y,
+                           size_t block_start, size_t block_size) {
+    for (size_t i = block_start; i < block_start + block_size; i++) {
+        if (x[i] != reference_x[i] || y[i] != reference_y[i]) {
+            return i;
+        }
+    }
+    return NO_MISMATCH;
+}
+
+/*
+ * Method streams the points through the hash and the step check
+ *
+ * If reference_hashes is NULL, the hashes of the blocks are stored to block_hashes.
+ * Otherwise they are compared with reference_hashes and the first differing block is stored to the result.
+ */
+void verify_points(unsigned degree, const coord_t* x, const coord_t* y, uint64_t* block_hashes,
+                   const uint64_t* reference_hashes, struct VerifyResult* result) {
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    const size_t block_size = points_number < VERIFY_BLOCK_SIZE ? points_number : VERIFY_BLOCK_SIZE;
+    const size_t blocks_count = points_number / block_size;
+
+    result->broken_steps = 0;
+    result->first_broken_step = 0;
+    result->has_mismatch = false;
+    result->mismatch_block = 0;
+    result->first_mismatch = NO_MISMATCH;
+    uint64_t hash = degree;
+    for (size_t block = 0; block < blocks_count; block++) {
+        const size_t block_start = block * block_size;
+        const uint64_t block_hash = hash_points(x + block_start, y + block_start, block_size, block);
+        result->broken_steps += count_broken_steps(x, y, block_start == 0 ? 1 : block_start, block_start + block_size,
+                                                   &result->first_broken_step);
+        if (reference_hashes == NULL) {
+            block_hashes[block] = block_hash;
+        } else if (!result->has_mismatch && block_hash != reference_hashes[block]) {
+            result->has_mismatch = true;
+            result->mismatch_block = block_start;
+        }
+        hash = hash_round(hash, block_hash);
+    }
+
+    // The curve is closed, so the last point is the neighbour of the first one
+    if (!is_unit_step(x[points_number - 1], y[points_number - 1], x[0], y[0])) {
+        if (result->broken_steps == 0) {
+            result->first_broken_step = points_number;
+        }
+        result->broken_steps++;
+    }
+    result->hash = hash;
+}
+
+/*
+ * Method searches the first differing point of the mismatching block in the points of the reference solution
+ *
+ * Only the hashes of the reference solution are kept, so its points are calculated again for the first mismatch
+ * and kept for the next solutions. Returns false if the memory for the reference points can not be allocated.
+ */
+bool locate_mismatch(unsigned degree, const coord_t* x, const coord_t* y, coord_t** reference_x, coord_t** reference_y,
+                     struct VerifyResult* result) {
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    const size_t block_size = points_number < VERIFY_BLOCK_SIZE ? points_number : VERIFY_BLOCK_SIZE;
+    if (*reference_x == NULL) {
+        *reference_x = allocate_coords(points_number);
+        *reference_y = allocate_coords(points_number);
+        if (*reference_x == NULL || *reference_y == NULL) {
+            free_coords(*reference_x, points_number);
+            free_coords(*reference_y, points_number);
+            *reference_x = NULL;
+            *reference_y = NULL;
+            return false;
+        }
+        calc_moore_curve_points(degree, *reference_x, *reference_y, REFERENCE_SOLUTION, false);
+    }
+    result->first_mismatch = find_first_mismatch(x, y, *reference_x, *reference_y, result->mismatch_block, block_size);
+    return true;
+}
+
+double seconds_since(const struct timespec* start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return end.tv_sec - start->tv_sec + 1e-9 * (end.tv_nsec - start->tv_nsec);
+}
+
+void print_verify_result(unsigned degree, int solution, const struct VerifyResult* result, double calc_time,
+                         double verify_time, const coord_t* x, const coord_t* y, const coord_t* reference_x,
+                         const coord_t* reference_y) {
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    printf("Solution %d (%s): hash %016llx, time %f, verification time %f", solution, solution_names[solution],
+           (unsigned long long) result->hash, calc_time, verify_time);
+    if (result->broken_steps == 0 && !result->has_mismatch) {
+        printf(", ok\n");
+        return;
+    }
+
+    printf("\n");
+    if (result->broken_steps > 0) {
+        const size_t to = result->first_broken_step % points_number;
+        printf("    %zu steps are not unit moves, the first one is from the point %zu (%u, %u) to the point %zu (%u, %u)\n",
+               result->broken_steps, result->first_broken_step - 1, x[result->first_broken_step - 1],
+               y[result->first_broken_step - 1], to, x[to], y[to]);
+    }
+    if (!result->has_mismatch) {
+        return;
+    }
+    if (reference_x == NULL) {
+        printf("    Points differ from the %s solution in the block starting at %zu, "
+               "the reference points can not be allocated to find the first differing index\n",
+               solution_names[REFERENCE_SOLUTION], result->mismatch_block);
+    } else if (result->first_mismatch == NO_MISMATCH) {
+        printf("    Hash of the block starting at %zu differs from the %s solution, but no point of the block differs\n",
+               result->mismatch_block, solution_names[REFERENCE_SOLUTION]);
+    } else {
+        const size_t i = result->first_mismatch;
+        printf("    Points differ from the %s solution, the first differing index is %zu: (%u, %u) instead of (%u, %u)\n",
+               solution_names[REFERENCE_SOLUTION], i, x[i], y[i], reference_x[i], reference_y[i]);
+    }
+}
+
+/*
+ * Method cross-checks the solutions without writing the points to files
+ *
+ * Points of every solution are hashed by blocks and compared with the hashes of the iterative solution.
+ * Every step must be a unit move and the last point must be the neighbour of the first one.
+ * If solution is -1, all solutions are verified. Returns 0 if all solutions are correct.
+ */
+int verify_moore_curve(unsigned degree, int solution, int solutions_count) {
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    const size_t blocks_count = points_number < VERIFY_BLOCK_SIZE ? 1 : points_number / VERIFY_BLOCK_SIZE;
+    coord_t* x = allocate_coords(points_number);
+    coord_t* y = allocate_coords(points_number);
+    uint64_t* reference_hashes = (uint64_t*) malloc(sizeof(uint64_t) * blocks_count);
+    if (x == NULL || y == NULL || reference_hashes == NULL) {
+        fprintf(stderr, "Failed memory allocation. Moore curve degree is too big\n");
+        free_coords(x, points_number);
+        free_coords(y, points_number);
+        free(reference_hashes);
+        return -1;
+    }
+
+    printf("Verification of the moore curve of degree %u (%zu points)\n", degree, points_number);
+    int failed_solutions = 0;
+    coord_t* reference_x = NULL;
+    coord_t* reference_y = NULL;
+    for (int current = REFERENCE_SOLUTION; current < solutions_count; current++) {
+        if (solution != -1 && current != solution && current != REFERENCE_SOLUTION) {
+            continue;
+        }
+
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        calc_moore_curve_points(degree, x, y, current, false);
+        if (malloc_is_failed()) {
+            fprintf(stderr, "Failed memory allocation. Moore curve degree is too big\n");
+            failed_solutions = -1;
+            break;
+        }
+        const double calc_time = seconds_since(&start);
+
+        struct VerifyResult result;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        verify_points(degree, x, y, reference_hashes, current == REFERENCE_SOLUTION ? NULL : reference_hashes, &result);
+        const double verify_time = seconds_since(&start);
+
+        if (result.has_mismatch && !locate_mismatch(degree, x, y, &reference_x, &reference_y, &result)) {
+            fprintf(stderr, "Failed memory allocation of the reference points\n");
+        }
+        print_verify_result(degree, current, &result, calc_time, verify_time, x, y, reference_x, reference_y);
+        if (result.broken_steps > 0 || result.has_mismatch) {
+            failed_solutions++;
+        }
+    }
+
+    free_coords(x, points_number);
+    free_coords(y, points_number);
+    free_coords(reference_x, points_number);
+    free_coords(reference_y, points_number);
+    free(reference_hashes);
+    return failed_solutions == 0 ? 0 : -1;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "moore_curve_walker.h"
+
+// Orientations of the squares of the Hilbert's curve. Composition of the orientations is xor
+#define ORIENTATION_IDENTITY 0
+#define ORIENTATION_TRANSPOSE 1
+#define ORIENTATION_ANTI_TRANSPOSE 2
+#define ORIENTATION_ROTATE 3
+
+/*
+ * Orientation of the quarter inside the square with identity orientation
+ *
+ * The first quarter is the transposed curve, the last one is the anti-transposed curve.
+ */
+static const uint8_t quarter_orientation[4] = {
+        ORIENTATION_TRANSPOSE, ORIENTATION_IDENTITY, ORIENTATION_IDENTITY, ORIENTATION_ANTI_TRANSPOSE
+};
+
+/*
+ * Position (x bit, y bit) of the quarter with the given digit inside the square with the given orientation
+ */
+static const uint8_t quarter_position[4][4][2] = {
+        {{0, 0}, {0, 1}, {1, 1}, {1, 0}}, // identity
+        {{0, 0}, {1, 0}, {1, 1}, {0, 1}}, // transpose
+        {{1, 1}, {0, 1}, {0, 0}, {1, 0}}, // anti-transpose
+        {{1, 1}, {1, 0}, {0, 0}, {0, 1}}  // rotate
+};
+
+void transform_to_moore(coord_t* x_ptr, coord_t* y_ptr, int quadrant, int moore_n);
+
+
+/*
+ * Method sets the bits of the level in the coordinates and the orientation of the level below it
+ */
+static inline void update_level(struct MooreWalker* walker, int level) {
+    const uint8_t orientation = walker->orientations[level];
+    const uint8_t digit = walker->digits[level];
+    const coord_t bit = (coord_t) 1 << level;
+    walker->hilbert_x = (walker->hilbert_x & ~bit) | (quarter_position[orientation][digit][0] ? bit : 0);
+    walker->hilbert_y = (walker->hilbert_y & ~bit) | (quarter_position[orientation][digit][1] ? bit : 0);
+    if (level > 0) {
+        walker->orientations[level - 1] = orientation ^ quarter_orientation[digit];
+    }
+}
+
+/*
+ * Method starts the walk from the point with the given index
+ */
+void moore_walker_init(struct MooreWalker* walker, unsigned degree, size_t index) {
+    walker->degree = degree;
+    walker->levels = (int) degree - 1;
+    walker->quadrant = (int) (index >> (2 * walker->levels)) & 3;
+    walker->hilbert_x = 0;
+    walker->hilbert_y = 0;
+    if (walker->levels > 0) {
+        walker->orientations[walker->levels - 1] = ORIENTATION_IDENTITY;
+    }
+    for (int level = walker->levels - 1; level >= 0; level--) {
+        walker->digits[level] = (index >> (2 * level)) & 3;
+        update_level(walker, level);
+    }
+}
+
+/*
+ * Method moves the walker to the next point. Only the levels from the lowest digit that is not 3 are recalculated
+ */
+void moore_walker_next(struct MooreWalker* walker) {
+    int level = 0;
+    while (level < walker->levels && walker->digits[level] == 3) {
+        walker->digits[level++] = 0;
+    }
+
+    if (level == walker->levels) {
+        // All digits were 3, so the walk goes to the next quarter of the moore curve
+        walker->quadrant = (walker->quadrant + 1) & 3;
+        level--;
+    } else {
+        walker->digits[level]++;
+    }
+
+    for (; level >= 0; level--) {
+        update_level(walker, level);
+    }
+}
+
+/*
+ * Method returns the current point of the walk
+ */
+void moore_walker_point(const struct MooreWalker* walker, coord_t* x, coord_t* y) {
+    *x = walker->hilbert_x;
+    *y = walker->hilbert_y;
+    transform_to_moore(x, y, walker->quadrant, walker->degree);
+}
+
+/*
+ * Method finds points coordinates of the moore curve walking along the curve from the first point.
+ *
+ * When degree <= 0 function will print an error.
+ */
+void moore_walker(unsigned degree, coord_t* x, coord_t* y) {
+    if (degree <= 0 || degree > 15) {
+        fprintf(stderr, "Moore curve degree must be between 1 and 15");
+        return;
+    }
+
+    const size_t points_number = (size_t) 1 << (2 * degree);
+    struct MooreWalker walker;
+    moore_walker_init(&walker, degree, 0);
+    for (size_t i = 0; i < points_number; i++) {
+        moore_walker_point(&walker, &x[i], &y[i]);
+        moore_walker_next(&walker);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef MOORE_CURVE_WALKER_H
+#define MOORE_CURVE_WALKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOORE_WALKER_MAX_LEVELS 15
+
+typedef uint32_t coord_t;
+
+/*
+ * State of the walk along the moore curve
+ *
+ * The index of the point in the Hilbert's curve of degree (degree - 1) is stored by its base 4 digits.
+ * Every digit selects one of the 4 quarters of the square of its level, and the orientation of that quarter
+ * depends only on the digits of the upper levels. Consecutive indexes share almost all digits,
+ * so only the levels whose digits changed are recalculated: 4/3 levels per point on average.
+ */
+struct MooreWalker {
+    unsigned degree;
+    int levels;
+    int quadrant; // quarter of the moore curve, see transform_to_moore
+    coord_t hilbert_x;
+    coord_t hilbert_y;
+    uint8_t digits[MOORE_WALKER_MAX_LEVELS];
+    uint8_t orientations[MOORE_WALKER_MAX_LEVELS]; // orientation of the square of every level
+};
+
+void moore_walker_init(struct MooreWalker* walker, unsigned degree, size_t index);
+
+void moore_walker_next(struct MooreWalker* walker);
+
+void moore_walker_point(const struct MooreWalker* walker, coord_t* x, coord_t* y);
+
+#endif // MOORE_CURVE_WALKER_H